@@ -87,26 +87,23 @@ relocate(THING *th, coord *new_loc)
 
     if (!ce(*new_loc, th->t_pos))
     {
-	mvaddch(th->t_pos.y, th->t_pos.x, th->t_oldch);
+	mvshow(th->t_pos.y, th->t_pos.x, th->t_oldch);
+	room_detach(th);
 	th->t_room = roomin(new_loc);
+	room_attach(th);
 	set_oldch(th, new_loc);
 	oroom = th->t_room;
 	moat(th->t_pos.y, th->t_pos.x) = NULL;
 
 	if (oroom != th->t_room)
-	    th->t_dest = find_dest(th);
+	    set_dest(th, find_dest(th));
 	th->t_pos = *new_loc;
 	moat(new_loc->y, new_loc->x) = th;
     }
-    move(new_loc->y, new_loc->x);
     if (see_monst(th))
-	addch(th->t_disguise);
+	mvshow(new_loc->y, new_loc->x, th->t_disguise);
     else if (on(player, SEEMONST))
-    {
-	standout();
-	addch(th->t_type);
-	standend();
-    }
+	mvshow(new_loc->y, new_loc->x, th->t_type | A_STANDOUT);
 }
 
 /*
@@ -126,7 +123,7 @@ do_chase(THING *th)
 
     rer = th->t_room;		/* Find room of chaser */
     if (on(*th, ISGREED) && rer->r_goldval == 0)
-	th->t_dest = &hero;	/* If gold has been taken, run after hero */
+	set_dest(th, &hero);	/* If gold has been taken, run after hero */
     if (th->t_dest == &hero)	/* Find room of chasee */
 	ree = proom;
     else
@@ -154,7 +151,7 @@ over:
 	}
 	if (door)
 	{
-	    rer = &passages[flat(th->t_pos.y, th->t_pos.x) & F_PNUM];
+	    rer = &passages[pnat(th->t_pos.y, th->t_pos.x)];
 	    door = FALSE;
 	    goto over;
 	}
@@ -199,29 +196,24 @@ over:
 	{
 	    int result = attack(th);
 	    /* Redraw monster after attack to prevent it from disappearing */
-	    move(th->t_pos.y, th->t_pos.x);
 	    if (see_monst(th))
-		addch(th->t_disguise);
+		mvshow(th->t_pos.y, th->t_pos.x, th->t_disguise);
 	    else if (on(player, SEEMONST))
-	    {
-		standout();
-		addch(th->t_type);
-		standend();
-	    }
+		mvshow(th->t_pos.y, th->t_pos.x, th->t_type | A_STANDOUT);
 	    return result;
 	}
 	else if (ce(this, *th->t_dest))
 	{
-	    for (obj = lvl_obj; obj != NULL; obj = next(obj))
-		if (th->t_dest == &obj->o_pos)
-		{
-		    detach(lvl_obj, obj);
-		    attach(th->t_pack, obj);
-		    chat(obj->o_pos.y, obj->o_pos.x) =
-			(th->t_room->r_flags & ISGONE) ? PASSAGE : FLOOR;
-		    th->t_dest = find_dest(th);
-		    break;
-		}
+	    obj = obat(th->t_dest->y, th->t_dest->x);
+	    if (obj != NULL && th->t_dest == &obj->o_pos)
+	    {
+		detach_obj(obj);
+		obj->o_claim = NULL;
+		attach(th->t_pack, obj);
+		chat(obj->o_pos.y, obj->o_pos.x) =
+		    (th->t_room->r_flags & ISGONE) ? PASSAGE : FLOOR;
+		set_dest(th, find_dest(th));
+	    }
 	    if (th->t_type != 'F')
 		stoprun = TRUE;
 	}
@@ -253,7 +245,7 @@ set_oldch(THING *tp, coord *cp)
         return;
 
     sch = tp->t_oldch;
-    tp->t_oldch = CCHAR( mvinch(cp->y,cp->x) );
+    tp->t_oldch = CCHAR( shown(cp->y, cp->x) );
     if (!on(player, ISBLIND))
     {
 	    if ((sch == FLOOR || tp->t_oldch == FLOOR) &&
@@ -314,7 +306,7 @@ runto(coord *runner)
      */
     tp->t_flags |= ISRUN;
     tp->t_flags &= ~ISHELD;
-    tp->t_dest = find_dest(tp);
+    set_dest(tp, find_dest(tp));
 }
 
 /*
@@ -333,7 +325,9 @@ chase(THING *tp, coord *ee)
     register char ch;
     register int plcnt = 1;
     static coord tryp;
+    int ors;
 
+    ors = rng_use(RS_MONST);
     /*
      * If the thing is confused, let it move randomly. Invisible
      * Stalkers are slightly confused all of the time, and bats are
@@ -393,11 +387,7 @@ chase(THING *tp, coord *ee)
 		     */
 		    if (ch == SCROLL)
 		    {
-			for (obj = lvl_obj; obj != NULL; obj = next(obj))
-			{
-			    if (y == obj->o_pos.y && x == obj->o_pos.x)
-				break;
-			}
+			obj = obat(y, x);
 			if (obj != NULL && obj->o_which == S_SCARE)
 			    continue;
 		    }
@@ -426,6 +416,7 @@ chase(THING *tp, coord *ee)
 	    }
 	}
     }
+    rng_use(ors);
     return (bool)(curdist != 0 && !ce(ch_ret, hero));
 }
 
@@ -443,7 +434,7 @@ roomin(coord *cp)
 
     fp = &flat(cp->y, cp->x);
     if (*fp & F_PASS)
-	return &passages[*fp & F_PNUM];
+	return &passages[pnat(cp->y, cp->x)];
 
     for (rp = rooms; rp < &rooms[MAXROOMS]; rp++)
 	if (cp->x <= rp->r_pos.x + rp->r_max.x && rp->r_pos.x <= cp->x
@@ -511,22 +502,72 @@ find_dest(THING *tp)
 {
     register THING *obj;
     register int prob;
+    int ors;
 
     if ((prob = monsters[tp->t_type - 'A'].m_carry) <= 0 || tp->t_room == proom
 	|| see_monst(tp))
 	    return &hero;
+    ors = rng_use(RS_MONST);
     for (obj = lvl_obj; obj != NULL; obj = next(obj))
     {
 	if (obj->o_type == SCROLL && obj->o_which == S_SCARE)
 	    continue;
-	if (roomin(&obj->o_pos) == tp->t_room && rnd(100) < prob)
+	if (roomin(&obj->o_pos) == tp->t_room && rnd(100) < prob
+	    && obj->o_claim == NULL)
 	{
-	    for (tp = mlist; tp != NULL; tp = next(tp))
-		if (tp->t_dest == &obj->o_pos)
-		    break;
-	    if (tp == NULL)
-		return &obj->o_pos;
+	    rng_use(ors);
+	    return &obj->o_pos;
 	}
     }
+    rng_use(ors);
     return &hero;
 }
+
+/*
+ * dest_obj:
+ *	Return the object on the floor that a destination points at, if any
+ */
+static THING *
+dest_obj(coord *cp)
+{
+    register THING *obj;
+
+    if (cp == NULL || cp == &hero)
+	return NULL;
+    obj = obat(cp->y, cp->x);
+    if (obj == NULL || &obj->o_pos != cp)
+	return NULL;
+    return obj;
+}
+
+/*
+ * set_dest:
+ *	Change where a monster is running to, moving its claim from the
+ *	object it wanted before (if any) to the one it wants now.
+ */
+void
+set_dest(THING *tp, coord *dest)
+{
+    register THING *obj;
+
+    if ((obj = dest_obj(tp->t_dest)) != NULL && obj->o_claim == tp)
+	obj->o_claim = NULL;
+    tp->t_dest = dest;
+    if ((obj = dest_obj(dest)) != NULL)
+	obj->o_claim = tp;
+}
+
+/*
+ * unclaim:
+ *	An object is leaving the floor, so whatever monster wanted it
+ *	gets mad and runs at the hero instead.
+ */
+void
+unclaim(THING *obj)
+{
+    if (obj->o_claim != NULL)
+    {
+	obj->o_claim->t_dest = &hero;
+	obj->o_claim = NULL;
+    }
+}
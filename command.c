@@ -17,6 +17,16 @@
 #include "rogue.h"
 #include "i18n.h"
 
+/*
+ * What the command being typed has so far
+ */
+static char countch, direction, newcount = FALSE;
+
+GAMEVAR command_vars[] = {
+    GV(countch), GV(direction), GV(newcount),
+    GV_END
+};
+
 /*
  * command:
  *	Process the user commands
@@ -28,7 +38,6 @@ command()
     register int ntimes = 1;			/* Number of player moves */
     char *fp;
     THING *mp;
-    static char countch, direction, newcount = FALSE;
 
     if (on(player, ISHASTE))
 	ntimes++;
@@ -39,6 +48,7 @@ command()
     do_fuses(BEFORE);
     while (ntimes--)
     {
+	turns++;
 	again = FALSE;
 	if (has_hit)
 	{
@@ -59,7 +69,9 @@ command()
 	lastscore = purse;
 	move(hero.y, hero.x);
 	if (!((running || count) && jump))
-	    refresh();			/* Draw screen */
+	    show_frame();		/* Draw screen */
+	else
+	    flush_map();
 	take = 0;
 	after = TRUE;
 	/*
@@ -77,7 +89,9 @@ command()
 		ch = countch;
 	    else
 	    {
-		ch = readchar();
+		observe();
+		dig_ahead();
+		ch = next_cmd();
 		move_on = FALSE;
 		if (mpos != 0)		/* Erase message if its there */
 		    msg("");
@@ -99,10 +113,12 @@ command()
 	     * check for prefixes
 	     */
 	    newcount = FALSE;
-	    if (isdigit(ch))
+	    if (isdigit(ch) || (action != NULL && action->a_count > 0))
 	    {
 		count = 0;
 		newcount = TRUE;
+		if (action != NULL)
+		    count = action->a_count;
 		while (isdigit(ch))
 		{
 		    count = count * 10 + (ch - '0');
@@ -152,18 +168,9 @@ over:
 	    switch (ch)
 	    {
 		case ',': {
-		    THING *obj = NULL;
-		    int found = 0;
-		    for (obj = lvl_obj; obj != NULL; obj = next(obj))
-    			{
-			    if (obj->o_pos.y == hero.y && obj->o_pos.x == hero.x)
-			    {
-				found=1;
-				break;
-			    }
-    			}
+		    THING *obj = obat(hero.y, hero.x);
 
-		    if (found) {
+		    if (obj != NULL) {
 			if (levit_check())
 			    ;
 			else
@@ -286,6 +293,7 @@ over:
 			after = FALSE;
 		when 'D': after = FALSE; discovered();
 		when CTRL('P'): after = FALSE; msg(huh);
+		when 'M': after = FALSE; msg_history();
 		when CTRL('R'):
 		    after = FALSE;
 		    clearok(curscr,TRUE);
@@ -605,6 +613,7 @@ init_helpstr()
     helpstr[idx++].h_desc = msg_get("MSG_HELP_OPTIONS");
     helpstr[idx++].h_desc = msg_get("MSG_HELP_REDRAW");
     helpstr[idx++].h_desc = msg_get("MSG_HELP_REPEAT_MSG");
+    helpstr[idx++].h_desc = msg_get("MSG_HELP_OLD_MESSAGES");
     helpstr[idx++].h_desc = msg_get("MSG_HELP_CANCEL");
     helpstr[idx++].h_desc = msg_get("MSG_HELP_SAVE");
     helpstr[idx++].h_desc = msg_get("MSG_HELP_QUIT");
@@ -893,6 +902,7 @@ norm:
 	    free(*guess);
 	*guess = malloc((unsigned int) strlen(prbuf) + 1);
 	strcpy(*guess, prbuf);
+	forget_names();
     }
 }
 
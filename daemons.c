@@ -99,7 +99,7 @@ unsee()
 
     for (th = mlist; th != NULL; th = next(th))
 	if (on(*th, ISINVIS) && see_monst(th))
-	    mvaddch(th->t_pos.y, th->t_pos.x, th->t_oldch);
+	    mvshow(th->t_pos.y, th->t_pos.x, th->t_oldch);
     player.t_flags &= ~CANSEE;
 }
 
@@ -211,7 +211,7 @@ come_down()
      */
     for (tp = lvl_obj; tp != NULL; tp = next(tp))
 	if (cansee(tp->o_pos.y, tp->o_pos.x))
-	    mvaddch(tp->o_pos.y, tp->o_pos.x, tp->o_type);
+	    mvshow(tp->o_pos.y, tp->o_pos.x, tp->o_type);
 
     /*
      * undo the monsters
@@ -219,18 +219,14 @@ come_down()
     seemonst = on(player, SEEMONST);
     for (tp = mlist; tp != NULL; tp = next(tp))
     {
-	move(tp->t_pos.y, tp->t_pos.x);
 	if (cansee(tp->t_pos.y, tp->t_pos.x))
 	    if (!on(*tp, ISINVIS) || on(player, CANSEE))
-		addch(tp->t_disguise);
+		mvshow(tp->t_pos.y, tp->t_pos.x, tp->t_disguise);
 	    else
-		addch(chat(tp->t_pos.y, tp->t_pos.x));
+		mvshow(tp->t_pos.y, tp->t_pos.x,
+		    chat(tp->t_pos.y, tp->t_pos.x));
 	else if (seemonst)
-	{
-	    standout();
-	    addch(tp->t_type);
-	    standend();
-	}
+	    mvshow(tp->t_pos.y, tp->t_pos.x, tp->t_type | A_STANDOUT);
     }
     msg(msg_get("MSG_DAEMON_SO_BORING"));
 }
@@ -244,21 +240,23 @@ visuals()
 {
     register THING *tp;
     register bool seemonst;
+    int ors;
 
     if (!after || (running && jump))
 	return;
+    ors = rng_use(RS_LOOK);
     /*
      * change the things
      */
     for (tp = lvl_obj; tp != NULL; tp = next(tp))
 	if (cansee(tp->o_pos.y, tp->o_pos.x))
-	    mvaddch(tp->o_pos.y, tp->o_pos.x, rnd_thing());
+	    mvshow(tp->o_pos.y, tp->o_pos.x, rnd_thing());
 
     /*
      * change the stairs
      */
     if (!seenstairs && cansee(stairs.y, stairs.x))
-	mvaddch(stairs.y, stairs.x, rnd_thing());
+	mvshow(stairs.y, stairs.x, rnd_thing());
 
     /*
      * change the monsters
@@ -266,21 +264,17 @@ visuals()
     seemonst = on(player, SEEMONST);
     for (tp = mlist; tp != NULL; tp = next(tp))
     {
-	move(tp->t_pos.y, tp->t_pos.x);
 	if (see_monst(tp))
 	{
 	    if (tp->t_type == 'X' && tp->t_disguise != 'X')
-		addch(rnd_thing());
+		mvshow(tp->t_pos.y, tp->t_pos.x, rnd_thing());
 	    else
-		addch(rnd(26) + 'A');
+		mvshow(tp->t_pos.y, tp->t_pos.x, rnd(26) + 'A');
 	}
 	else if (seemonst)
-	{
-	    standout();
-	    addch(rnd(26) + 'A');
-	    standend();
-	}
+	    mvshow(tp->t_pos.y, tp->t_pos.x, (rnd(26) + 'A') | A_STANDOUT);
     }
+    rng_use(ors);
 }
 
 /*
@@ -19,24 +19,33 @@ bool again;				/* Repeating the last command */
 int  noscore;				/* Was a wizard sometime */
 bool seenstairs;			/* Have seen the stairs (for lsd) */
 bool amulet = FALSE;			/* He found the amulet */
+bool animate = TRUE;			/* Show things flying across the screen */
 bool door_stop = FALSE;			/* Stop running when we pass a door */
+bool fast_rng = FALSE;			/* New games use the fast generator */
 bool fight_flush = FALSE;		/* True if toilet input */
 bool firstmove = FALSE;			/* First move after setting door_stop */
 bool got_ltc = FALSE;			/* We have gotten the local tty chars */
 bool has_hit = FALSE;			/* Has a "hit" message pending in msg */
+bool headless = FALSE;			/* Nobody is watching the screen */
 bool in_shell = FALSE;			/* True if executing a shell */
 bool inv_describe = TRUE;		/* Say which way items are being used */
 bool jump = FALSE;			/* Show running as series of jumps */
 bool kamikaze = FALSE;			/* to_death really to DEATH */
+bool level_cache = FALSE;		/* Keep levels to dig them only once */
 bool lower_msg = FALSE;			/* Messages should start w/lower case */
+bool more_msg = TRUE;			/* Wait at --More-- for each message */
 bool move_on = FALSE;			/* Next move shouldn't pick up items */
 bool msg_esc = FALSE;			/* Check for ESC from msg's --More-- */
 bool passgo = FALSE;			/* Follow passages */
 bool playing = TRUE;			/* True until he quits */
+bool pre_dig = FALSE;			/* Dig the next level while waiting */
 bool q_comm = FALSE;			/* Are we executing a 'Q' command? */
+bool replaying = FALSE;			/* Keys come from a recorded game */
+bool restored = FALSE;			/* Game was started from a save file */
 bool running = FALSE;			/* True if player is running */
 bool save_msg = TRUE;			/* Remember last msg */
 bool see_floor = TRUE;			/* Show the lamp illuminated floor */
+bool serving = FALSE;			/* Games are played over sockets */
 bool stat_msg = FALSE;			/* Should status() print as a msg() */
 bool terse = FALSE;			/* True if we should be short */
 bool to_death = FALSE;			/* Fighting is to the death! */
@@ -50,6 +59,12 @@ bool pack_used[26] = {			/* Is the character used in the pack? */
     FALSE, FALSE, FALSE, FALSE, FALSE, FALSE, FALSE, FALSE
 };
 
+char cache_dir[MAXSTR] = { '\0' };	/* Where kept levels go on disk */
+char obs_file[MAXSTR] = { '\0' };	/* Where observations go */
+char act_file[MAXSTR] = { '\0' };	/* Where actions come from */
+char rec_file[MAXSTR] = { '\0' };	/* Where typed keys are recorded */
+char tty_file[MAXSTR] = { '\0' };	/* Where the screen is recorded */
+char watch_file[MAXSTR] = { '\0' };	/* Where the screen is watched */
 char dir_ch;				/* Direction from last get_dir() call */
 char file_name[MAXSTR];			/* Save file name */
 char huh[MAXSTR];			/* The last message printed */
@@ -76,14 +91,19 @@ char *tr_name[8];			/* Names of the traps (initialized by init_traps()) */
 
 int n_objs;				/* # items listed in inventory() call */
 int ntraps;				/* Number of traps on this level */
+int frame_rate = 0;			/* Most frames a second while running */
 int hungry_state = 0;			/* How hungry is he */
 int inpack = 0;				/* Number of things in pack */
 int inv_type = 0;			/* Type of inventory to use */
 int level = 1;				/* What level she is on */
 int max_hit;				/* Max damage done to her in to_death */
 int max_level;				/* Deepest player has gone */
+int mon_seq = 0;			/* t_seq of the newest monster */
 int mpos = 0;				/* Where cursor is on top line */
 int no_food = 0;			/* Number of levels without food */
+long floor_tries = 0;			/* Spots find_floor() has looked at */
+long room_tries = 0;			/* Rooms rnd_room() has looked at */
+long turns = 0;				/* Times round the command loop */
 int a_class[MAXARMORS] = {		/* Armor class for each armor type */
 	8,	/* LEATHER */
 	7,	/* RING_MAIL */
@@ -106,7 +126,9 @@ int quiet = 0;				/* Number of quiet turns */
 int vf_hit = 0;				/* Number of time flytrap has hit */
 
 int dnum;				/* Dungeon number */
-int seed;				/* Random number seed */
+RNG game_rng[NSTREAMS];			/* Random numbers for this game */
+RNG *streams = game_rng;		/* Streams of the game being played */
+RNG *rng = game_rng;			/* Stream the game draws from now */
 int e_levels[] = {
         10L,
 	20L,
@@ -131,6 +153,8 @@ int e_levels[] = {
 	 0L
 };
 
+ACTION *action = NULL;			/* Action being carried out */
+
 coord delta;				/* Change indicated to get_dir() */
 coord oldpos;				/* Position before last look() call */
 coord stairs;				/* Location of staircase */
@@ -155,21 +179,7 @@ struct stats max_stats = INIT_STATS;	/* The maximum for the player */
 
 struct room *oldrp;			/* Roomin(&oldpos) */
 struct room rooms[MAXROOMS];		/* One for each room -- A level */
-struct room passages[MAXPASS] =		/* One for each passage */
-{
-    { {0, 0}, {0, 0}, {0, 0}, 0, ISGONE|ISDARK, 0, {{0,0}} },
-    { {0, 0}, {0, 0}, {0, 0}, 0, ISGONE|ISDARK, 0, {{0,0}} },
-    { {0, 0}, {0, 0}, {0, 0}, 0, ISGONE|ISDARK, 0, {{0,0}} },
-    { {0, 0}, {0, 0}, {0, 0}, 0, ISGONE|ISDARK, 0, {{0,0}} },
-    { {0, 0}, {0, 0}, {0, 0}, 0, ISGONE|ISDARK, 0, {{0,0}} },
-    { {0, 0}, {0, 0}, {0, 0}, 0, ISGONE|ISDARK, 0, {{0,0}} },
-    { {0, 0}, {0, 0}, {0, 0}, 0, ISGONE|ISDARK, 0, {{0,0}} },
-    { {0, 0}, {0, 0}, {0, 0}, 0, ISGONE|ISDARK, 0, {{0,0}} },
-    { {0, 0}, {0, 0}, {0, 0}, 0, ISGONE|ISDARK, 0, {{0,0}} },
-    { {0, 0}, {0, 0}, {0, 0}, 0, ISGONE|ISDARK, 0, {{0,0}} },
-    { {0, 0}, {0, 0}, {0, 0}, 0, ISGONE|ISDARK, 0, {{0,0}} },
-    { {0, 0}, {0, 0}, {0, 0}, 0, ISGONE|ISDARK, 0, {{0,0}} }
-};
+struct room passages[MAXPASS];		/* One for each passage */
 
 #define ___ 1
 #define XX 10
@@ -369,6 +379,7 @@ struct h_list helpstr[] = {
     {'o',	NULL,	TRUE},
     {CTRL('R'),	NULL,	TRUE},
     {CTRL('P'),	NULL,	TRUE},
+    {'M',	NULL,	TRUE},
     {ESCAPE,	NULL,	TRUE},
     {'S',	NULL,	TRUE},
     {'Q',	NULL,	TRUE},
@@ -377,3 +388,39 @@ struct h_list helpstr[] = {
     {'v',	NULL,	TRUE},
     {0,		NULL, FALSE }
 };
+
+/*
+ * What belongs to each game, for a process that keeps many of them
+ * (see game.c).  What every game shares, the names and the help, is
+ * left out, and so is the screen, which curses switches itself.
+ */
+GAMEVAR extern_vars[] = {
+    GV(after), GV(again), GV(noscore), GV(seenstairs), GV(amulet),
+    GV(animate), GV(door_stop), GV(fast_rng), GV(fight_flush),
+    GV(firstmove), GV(has_hit), GV(in_shell), GV(inv_describe), GV(jump),
+    GV(kamikaze), GV(level_cache), GV(lower_msg), GV(more_msg), GV(move_on),
+    GV(msg_esc), GV(passgo), GV(playing), GV(pre_dig), GV(q_comm),
+    GV(running), GV(save_msg), GV(see_floor), GV(stat_msg), GV(terse),
+    GV(to_death), GV(tombstone),
+#ifdef MASTER
+    GV(wizard),
+#endif
+    GV(pack_used), GV(cache_dir), GV(obs_file), GV(act_file),
+    GV(rec_file), GV(tty_file), GV(watch_file), GV(dir_ch), GV(file_name), GV(huh),
+    GV(p_colors), GV(prbuf), GV(r_stones), GV(runch), GV(s_names),
+    GV(take), GV(whoami), GV(ws_made), GV(ws_type), GV(fruit),
+    GV(l_last_comm), GV(l_last_dir), GV(last_comm), GV(last_dir),
+    GV(n_objs), GV(ntraps), GV(frame_rate), GV(hungry_state), GV(inpack),
+    GV(inv_type), GV(level), GV(max_hit), GV(max_level), GV(mon_seq), GV(mpos),
+    GV(no_food), GV(floor_tries), GV(room_tries), GV(turns), GV(count),
+    GV(food_left), GV(lastscore), GV(no_command), GV(no_move), GV(purse),
+    GV(quiet), GV(vf_hit), GV(dnum), GV(game_rng), GV(streams), GV(rng),
+    GV(action), GV(delta), GV(oldpos), GV(stairs), GV(places),
+    GV(cur_armor), GV(cur_ring), GV(cur_weapon), GV(l_last_pick),
+    GV(last_pick), GV(lvl_obj), GV(mlist), GV(player), GV(hw),
+    GV(max_stats), GV(oldrp), GV(rooms), GV(passages), GV(monsters),
+    GV(things), GV(arm_info), GV(pot_info), GV(ring_info), GV(scr_info),
+    GV(weap_info), GV(ws_info), GV(d_list), GV(between), GV(group),
+    GV(nh),
+    GV_END
+};
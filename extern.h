@@ -103,10 +103,10 @@
 #undef SIGTSTP
 
 #define MAXSTR		1024	/* maximum length of strings */
-#define MAXLINES	32	/* maximum number of screen lines used */
-#define MAXCOLS		80	/* maximum number of screen columns used */
+#define MAXLINES	(1 << LINESHIFT)	/* map lines, rounded up to a power of 2 */
+#define MAXCOLS		NUMCOLS	/* maximum number of screen columns used */
 
-#define RN		(((seed = seed*11109+13849) >> 16) & 0xffff)
+#define RN		rng_next(rng)
 #ifdef CTRL
 #undef CTRL
 #endif
@@ -116,7 +116,7 @@
  * Now all the global variables
  */
 
-extern bool	got_ltc, in_shell;
+extern bool	got_ltc, in_shell, serving;
 extern int	wizard;
 extern char	fruit[], prbuf[], whoami[];
 extern int orig_dsusp;
@@ -138,6 +138,7 @@ void    leave(int);
 void	my_exit();
 void	nohaste();
 void	playit();
+void	session_flush();
 void    playltchars(void);
 void	print_disc(char);
 void    quit(int);
@@ -154,6 +155,7 @@ void	unsee();
 void	visuals();
 
 char	add_line(char *fmt, char *arg);
+char	add_text(char *str);
 
 char	*killname(char monst, bool doart);
 char	*nothing(char type);
@@ -167,6 +169,7 @@ int	md_chmod(char *filename, int mode);
 char	*md_crypt(char *key, char *salt);
 int	md_dsuspchar();
 int	md_erasechar();
+void	md_flushinp();
 char	*md_gethomedir();
 char	*md_getusername();
 int	md_getuid();
@@ -174,7 +177,9 @@ char	*md_getpass(char *prompt);
 int	md_getpid();
 char	*md_getrealname(int uid);
 void	md_init();
+int	md_keydecode(const unsigned char *buf, int len, int *used, bool more);
 int	md_killchar();
+long	md_msecs();
 void	md_normaluser();
 void	md_raw_standout();
 void	md_raw_standend();
@@ -182,6 +187,7 @@ int	md_readchar();
 int	md_setdsuspchar(int c);
 int	md_shellescape();
 void	md_sleep(int s);
+void	md_msleep(int ms);
 int	md_suspchar();
 int	md_hasclreol();
 int	md_unlink(char *file);
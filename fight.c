@@ -94,7 +94,7 @@ fight(coord *mp, THING *weap, bool thrown)
 	tp->t_disguise = 'X';
 	if (on(player, ISHALU)) {
 	    ch = (char)(rnd(26) + 'A');
-	    mvaddch(tp->t_pos.y, tp->t_pos.x, ch);
+	    mvshow(tp->t_pos.y, tp->t_pos.x, ch);
 	}
 	msg(choose_str(msg_get("MSG_FIGHT_HEAVY"),
 		       msg_get("MSG_FIGHT_WAIT")));
@@ -160,7 +160,7 @@ attack(THING *mp)
     {
 	mp->t_disguise = 'X';
 	if (on(player, ISHALU))
-	    mvaddch(mp->t_pos.y, mp->t_pos.x, rnd(26) + 'A');
+	    mvshow(mp->t_pos.y, mp->t_pos.x, rnd(26) + 'A');
     }
     mname = set_mname(mp);
     oldhp = pstats.s_hpt;
@@ -353,7 +353,7 @@ attack(THING *mp)
 const char *
 set_mname(THING *tp)
 {
-    int ch;
+    int ch, ors;
     const char *mname;
     static char tbuf[MAXSTR];
     static const char *monster_msg_keys[] = {
@@ -372,10 +372,13 @@ set_mname(THING *tp)
 	return (terse ? msg_get("MSG_IT") : msg_get("MSG_SOMETHING"));
     else if (on(player, ISHALU))
     {
-	move(tp->t_pos.y, tp->t_pos.x);
-	ch = toascii(inch());
+	ch = CCHAR(shown(tp->t_pos.y, tp->t_pos.x));
 	if (!isupper(ch))
+	{
+	    ors = rng_use(RS_LOOK);
 	    ch = rnd(26);
+	    rng_use(ors);
+	}
 	else
 	    ch -= 'A';
 	mname = msg_get(monster_msg_keys[ch]);
@@ -393,9 +396,12 @@ set_mname(THING *tp)
 int
 swing(int at_lvl, int op_arm, int wplus)
 {
-    int res = rnd(20);
+    int res, ors;
     int need = (20 - at_lvl) - op_arm;
 
+    ors = rng_use(RS_FIGHT);
+    res = rnd(20);
+    rng_use(ors);
     return (res + wplus >= need);
 }
 
@@ -413,7 +419,9 @@ roll_em(THING *thatt, THING *thdef, THING *weap, bool hurl)
     register int hplus;
     register int dplus;
     register int damage;
+    int ors;
 
+    ors = rng_use(RS_FIGHT);
     att = &thatt->t_stats;
     def = &thdef->t_stats;
     if (weap == NULL)
@@ -490,6 +498,7 @@ roll_em(THING *thatt, THING *thdef, THING *weap, bool hurl)
 	    break;
 	cp++;
     }
+    rng_use(ors);
     return did_hit;
 }
 
@@ -634,6 +643,7 @@ remove_mon(coord *mp, THING *tp, bool waskill)
 {
     register THING *obj, *nexti;
 
+    set_dest(tp, NULL);
     for (obj = tp->t_pack; obj != NULL; obj = nexti)
     {
 	nexti = next(obj);
@@ -645,8 +655,9 @@ remove_mon(coord *mp, THING *tp, bool waskill)
 	    discard(obj);
     }
     moat(mp->y, mp->x) = NULL;
-    mvaddch(mp->y, mp->x, tp->t_oldch);
+    mvshow(mp->y, mp->x, tp->t_oldch);
     detach(mlist, tp);
+    room_detach(tp);
     if (on(*tp, ISTARGET))
     {
 	kamikaze = FALSE;
@@ -0,0 +1,79 @@
+/*
+ * Keeping the state of one game apart, so that one process can hold
+ * many games and take turns running them
+ *
+ * Everything a game changes lives in globals, here in extern.c and in
+ * a few modules of their own.  Rather than hand a context to every
+ * function, the globals are copied out to a blob when a game stops to
+ * wait for a key and copied back in when it goes on.  Pointers among
+ * them stay good, since every game has its globals at the same
+ * addresses; what is on the heap belongs to each game by itself.
+ *
+ * Rogue: Exploring the Dungeons of Doom
+ * Copyright (C) 1980-1983, 1985, 1999 Michael Toy, Ken Arnold and Glenn Wichman
+ * All rights reserved.
+ *
+ * See the file LICENSE.TXT for full copyright and licensing information.
+ */
+
+#include <string.h>
+#include <curses.h>
+#include "rogue.h"
+
+static GAMEVAR *game_vars[] = {
+    extern_vars, command_vars, io_vars, levels_vars, misc_vars,
+    sticks_vars, things_vars, NULL
+};
+
+/*
+ * game_size:
+ *	How big a blob holding a game has to be
+ */
+
+size_t
+game_size()
+{
+    GAMEVAR **lp, *vp;
+    size_t size = 0;
+
+    for (lp = game_vars; *lp != NULL; lp++)
+	for (vp = *lp; vp->gv_addr != NULL; vp++)
+	    size += vp->gv_size;
+    return size;
+}
+
+/*
+ * game_save:
+ *	Copy the game being played out to blob
+ */
+
+void
+game_save(char *blob)
+{
+    GAMEVAR **lp, *vp;
+
+    for (lp = game_vars; *lp != NULL; lp++)
+	for (vp = *lp; vp->gv_addr != NULL; vp++)
+	{
+	    memcpy(blob, vp->gv_addr, vp->gv_size);
+	    blob += vp->gv_size;
+	}
+}
+
+/*
+ * game_load:
+ *	Make the game in blob the one being played
+ */
+
+void
+game_load(char *blob)
+{
+    GAMEVAR **lp, *vp;
+
+    for (lp = game_vars; *lp != NULL; lp++)
+	for (vp = *lp; vp->gv_addr != NULL; vp++)
+	{
+	    memcpy(vp->gv_addr, blob, vp->gv_size);
+	    blob += vp->gv_size;
+	}
+}
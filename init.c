@@ -14,9 +14,88 @@
 #include <curses.h>
 #include <ctype.h>
 #include <string.h>
+#include <time.h>
 #include "rogue.h"
 #include "i18n.h"
 
+/*
+ * init_seed:
+ *	Pick the seed, name and options the game starts with.  A game
+ *	being played back with -p brings its own; otherwise they come
+ *	from ROGUEOPTS and the clock.  Returns how many of the arguments
+ *	are left for main() to look at, or -1 if the recording is bad.
+ */
+int
+init_seed(int argc, char **argv)
+{
+    char *env;
+    int lowtime;
+
+    if (argc == 3 && strcmp(argv[1], "-p") == 0)
+    {
+	if (!start_replay(argv[2]))
+	    return -1;
+	argc = 1;
+    }
+    else
+    {
+	if ((env = getenv("ROGUEOPTS")) != NULL)
+	    parse_opts(env);
+	if (env == NULL || whoami[0] == '\0')
+	    strucpy(whoami, md_getusername(), (int) strlen(md_getusername()));
+	lowtime = (int) time(NULL);
+#ifdef MASTER
+	if (wizard && getenv("SEED") != NULL)
+	    dnum = atoi(getenv("SEED"));
+	else
+#endif
+	    dnum = lowtime + md_getpid();
+    }
+    rng_seed(fast_rng ? RNG_FAST : RNG_LEGACY, dnum);
+    return argc;
+}
+
+/*
+ * init_tables:
+ *	Set up what every game shares, the tables and the names in the
+ *	language being used
+ */
+void
+init_tables()
+{
+    init_probs();			/* Set up prob tables for objects */
+    init_rainbow();			/* Initialize rainbow with translated colors */
+    init_stones_array();		/* Initialize stones with translated names */
+    init_wood_array();			/* Initialize wood with translated names */
+    init_metal_array();			/* Initialize metal with translated names */
+    init_monsters();			/* Initialize monster names */
+    init_potions();			/* Initialize potion effect names */
+    init_scrolls();			/* Initialize scroll effect names */
+    init_rings();			/* Initialize ring effect names */
+    init_sticks();			/* Initialize wand/staff effect names */
+    init_armors();                      /* Initialize armor names */
+    init_weapons();                     /* Initialize weapon names */
+    init_inv_t_name();			/* Initialize inventory type names */
+    init_options();			/* Initialize option prompt strings */
+    init_fruit();			/* Initialize default fruit name */
+    init_traps();			/* Set up trap names */
+    init_help();			/* Set up help strings */
+}
+
+/*
+ * init_game:
+ *	Set up what each game rolls for itself
+ */
+void
+init_game()
+{
+    init_player();			/* Set up initial player stats */
+    init_names();			/* Set up names of scrolls */
+    init_colors();			/* Set up colors of potions */
+    init_stones();			/* Set up stone settings of rings */
+    init_materials();			/* Set up materials of wands */
+}
+
 /*
  * init_player:
  *	Roll her up
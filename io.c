@@ -20,6 +20,17 @@
 static char msgbuf[2*MAXMSG+1];
 static int newpos = 0;
 
+/*
+ * The messages that have been shown, for the history command and for
+ * programs that play rogue.  Only the last MSGLOG are remembered.
+ */
+static struct {
+    long ml_turn;			/* Turn it was shown on */
+    char ml_text[2*MAXMSG+1];		/* What it said */
+} msg_log[MSGLOG];
+static int nmsgs = 0;			/* How many have been shown in all */
+static bool logging = TRUE;		/* Off while the log is shown */
+
 /* VARARGS1 */
 int
 msg(const char *fmt, ...)
@@ -76,10 +87,11 @@ endmsg()
 
     if (save_msg)
 	strcpy(huh, msgbuf);
-    if (mpos)
+    if (mpos && more_msg)
     {
 	look(FALSE);
 	mvaddstr(0, mpos, msg_get("MSG_MORE"));
+	flush_map();
 	refresh();
 	if (!msg_esc)
 	    wait_for(' ');
@@ -102,32 +114,98 @@ endmsg()
      */
     if (islower(msgbuf[0]) && !lower_msg && msgbuf[1] != ')')
 	msgbuf[0] = (char) toupper(msgbuf[0]);
+    if (logging && msgbuf[0] != '\0')
+    {
+	msg_log[nmsgs % MSGLOG].ml_turn = turns;
+	strcpy(msg_log[nmsgs % MSGLOG].ml_text, msgbuf);
+	nmsgs++;
+    }
     mvaddstr(0, 0, msgbuf);
     clrtoeol();
     mpos = newpos;
     newpos = 0;
     msgbuf[0] = '\0';
+    flush_map();
     refresh();
     return ~ESCAPE;
 }
 
 /*
  * doadd:
- *	Perform an add onto the message buffer
+ *	Perform an add onto the message buffer.  It is printed straight
+ *	onto the end of what is there; if it will not fit on the line
+ *	with that, that goes out first and it is printed again at the
+ *	start.
  */
 void
 doadd(const char *fmt, va_list args)
 {
-    static char buf[MAXSTR];
+    va_list again;
+    int len;
 
-    /*
-     * Do the printf into buf
-     */
-    vsprintf(buf, fmt, args);
-    if (strlen(buf) + newpos >= MAXMSG)
-        endmsg(); 
-    strcat(msgbuf, buf);
-    newpos = (int) strlen(msgbuf);
+    va_copy(again, args);
+    len = vsnprintf(&msgbuf[newpos], sizeof msgbuf - newpos, fmt, args);
+    if (len + newpos >= (int) MAXMSG)
+    {
+	msgbuf[newpos] = '\0';
+	endmsg();
+	len = vsnprintf(msgbuf, sizeof msgbuf, fmt, again);
+    }
+    va_end(again);
+    if (len > 0)
+	newpos += len;
+    if (newpos >= (int) sizeof msgbuf)
+	newpos = sizeof msgbuf - 1;
+}
+
+/*
+ * old_msg:
+ *	The nth message back, 0 being the last one shown, and the turn
+ *	it was shown on; NULL once it is too old to be remembered
+ */
+char *
+old_msg(int n, long *turnp)
+{
+    int i;
+
+    if (n < 0 || n >= nmsgs || n >= MSGLOG)
+	return NULL;
+    i = (nmsgs - 1 - n) % MSGLOG;
+    if (turnp != NULL)
+	*turnp = msg_log[i].ml_turn;
+    return msg_log[i].ml_text;
+}
+
+/*
+ * msg_count:
+ *	How many messages have been shown since the game started
+ */
+int
+msg_count()
+{
+    return nmsgs;
+}
+
+/*
+ * msg_history:
+ *	Show the messages that are remembered, oldest first
+ */
+void
+msg_history()
+{
+    int n;
+
+    if (nmsgs == 0)
+    {
+	msg(msg_get("MSG_NO_OLD_MESSAGES"));
+	return;
+    }
+    logging = FALSE;
+    for (n = (nmsgs < MSGLOG ? nmsgs : MSGLOG) - 1; n >= 0; n--)
+	if (add_text(old_msg(n, NULL)) == ESCAPE)
+	    break;
+    end_line();
+    logging = TRUE;
 }
 
 /*
@@ -157,7 +235,23 @@ readchar()
 {
     char ch;
 
-    ch = (char) md_readchar();
+    /*
+     * Actions answer their own questions, and the keyboard is not
+     * read while one is being carried out
+     */
+    if (action != NULL)
+	return ESCAPE;
+    if (replaying)
+	ch = replay_key();
+    else if (serving)
+	ch = session_key();
+    else
+    {
+	put_ttyrec(TRUE);
+	put_watch();
+	ch = (char) md_readchar();
+	record_key(ch);
+    }
 
     if (ch == 3)
     {
@@ -168,6 +262,77 @@ readchar()
     return(ch);
 }
 
+/*
+ * The status line is kept as the fields it is made of.  A field is
+ * only formatted again when what it shows changes, and then only its
+ * own characters are drawn, unless it came out longer or shorter; then
+ * the fields after it have moved and are drawn again too.
+ */
+#define ST_LEVEL	0
+#define ST_GOLD		1
+#define ST_HP		2
+#define ST_STR		3
+#define ST_ARM		4
+#define ST_EXP		5
+#define ST_HUNGER	6
+#define NSTATS		7
+#define ST_LEN		40		/* Longest a field can be */
+
+static struct {
+    int st_a, st_b;			/* What it shows */
+    int st_col, st_end;			/* Where it is on the line */
+    char st_text[ST_LEN];		/* What it looks like */
+} stats[NSTATS];
+static bool stat_shown = FALSE;		/* stats[] is what the line has */
+static int hpwidth = 0;			/* Digits in max_hp */
+
+/*
+ * fmt_stat:
+ *	Format field i of the status line into buf, showing a and b
+ */
+static void
+fmt_stat(char *buf, int i, int a, int b)
+{
+    static const char *label[NSTATS], *fmt[NSTATS];
+    static const char *hunger[4];
+    int temp;
+
+    /*
+     * The labels and formats never change, so they are only looked up once
+     */
+    if (label[0] == NULL)
+    {
+	label[ST_LEVEL] = msg_get("MSG_LEVEL");
+	label[ST_GOLD] = msg_get("MSG_GOLD");
+	label[ST_HP] = msg_get("MSG_HP");
+	label[ST_STR] = msg_get("MSG_STR");
+	label[ST_ARM] = msg_get("MSG_ARM");
+	label[ST_EXP] = msg_get("MSG_EXP");
+	fmt[ST_LEVEL] = msg_get("MSG_STATUS_LEVEL_FMT");
+	fmt[ST_GOLD] = msg_get("MSG_STATUS_GOLD_FMT");
+	fmt[ST_HP] = msg_get("MSG_STATUS_HP_FMT");
+	fmt[ST_STR] = msg_get("MSG_STATUS_STR_FMT");
+	fmt[ST_ARM] = msg_get("MSG_STATUS_ARM_FMT");
+	fmt[ST_EXP] = msg_get("MSG_STATUS_EXP_FMT");
+	hunger[0] = "";
+	hunger[1] = msg_get("MSG_HUNGRY");
+	hunger[2] = msg_get("MSG_WEAK");
+	hunger[3] = msg_get("MSG_FAINT");
+    }
+    switch (i)
+    {
+	case ST_HP:
+	    if (b != stats[ST_HP].st_b || hpwidth == 0)
+		for (hpwidth = 0, temp = b; temp; hpwidth++)
+		    temp /= 10;
+	    snprintf(buf, ST_LEN, fmt[i], label[i], hpwidth, a, hpwidth, b);
+	when ST_HUNGER:
+	    snprintf(buf, ST_LEN, "%s", hunger[a]);
+	otherwise:
+	    snprintf(buf, ST_LEN, fmt[i], label[i], a, b);
+    }
+}
+
 /*
  * status:
  *	Display the important stats line.  Keep the cursor where it was.
@@ -175,87 +340,222 @@ readchar()
 void
 status()
 {
-    register int oy, ox, temp;
-    static int hpwidth = 0;
-    static int s_hungry = 0;
-    static int s_lvl = 0;
-    static int s_pur = -1;
-    static int s_hp = 0;
-    static int s_arm = 0;
-    static str_t s_str = 0;
-    static int s_exp = 0;
-    static char *state_name[] =
-    {
-	"", NULL, NULL, NULL
-    };
+    int val[NSTATS][2];
+    bool redraw[NSTATS];
+    char line[NSTATS * ST_LEN], buf[ST_LEN];
+    int oy, ox, i, from;
 
-    /* Initialize state names with translated strings if not done yet */
-    if (state_name[1] == NULL)
+    val[ST_LEVEL][0] = level;
+    val[ST_GOLD][0] = purse;
+    val[ST_HP][0] = pstats.s_hpt;
+    val[ST_HP][1] = max_hp;
+    val[ST_STR][0] = pstats.s_str;
+    val[ST_STR][1] = max_stats.s_str;
+    val[ST_ARM][0] = 10 - (cur_armor != NULL ? cur_armor->o_arm : pstats.s_arm);
+    val[ST_EXP][0] = pstats.s_lvl;
+    val[ST_EXP][1] = pstats.s_exp;
+    val[ST_HUNGER][0] = hungry_state;
+    val[ST_LEVEL][1] = val[ST_GOLD][1] = val[ST_ARM][1] = val[ST_HUNGER][1] = 0;
+
+    if (stat_msg)
     {
-	state_name[1] = (char *)msg_get("MSG_HUNGRY");
-	state_name[2] = (char *)msg_get("MSG_WEAK");
-	state_name[3] = (char *)msg_get("MSG_FAINT");
+	line[0] = '\0';
+	for (i = 0; i < NSTATS; i++)
+	{
+	    fmt_stat(buf, i, val[i][0], val[i][1]);
+	    if (i > 0)
+		strcat(line, "  ");
+	    strcat(line, buf);
+	}
+	move(0, 0);
+	msg("%s", line);
+	return;
     }
 
     /*
-     * If nothing has changed since the last status, don't
-     * bother.
+     * Format the fields that changed.  From the first one that
+     * changed length on, everything is drawn.
      */
-    temp = (cur_armor != NULL ? cur_armor->o_arm : pstats.s_arm);
-    if (s_hp == pstats.s_hpt && s_exp == pstats.s_exp && s_pur == purse
-	&& s_arm == temp && s_str == pstats.s_str && s_lvl == level
-	&& s_hungry == hungry_state
-	&& !stat_msg
-	)
+    from = (stat_shown ? NSTATS : 0);
+    for (i = 0; i < NSTATS; i++)
+    {
+	redraw[i] = !stat_shown || val[i][0] != stats[i].st_a
+	    || val[i][1] != stats[i].st_b;
+	if (!redraw[i])
+	    continue;
+	fmt_stat(buf, i, val[i][0], val[i][1]);
+	if (strlen(buf) != strlen(stats[i].st_text) && i < from)
+	    from = i;
+	strcpy(stats[i].st_text, buf);
+	stats[i].st_a = val[i][0];
+	stats[i].st_b = val[i][1];
+    }
+    if (from == NSTATS)
+    {
+	for (i = 0; i < NSTATS; i++)
+	    if (redraw[i])
+		break;
+	if (i == NSTATS)
 	    return;
-
-    s_arm = temp;
+    }
 
     getyx(stdscr, oy, ox);
-    if (s_hp != max_hp)
+    for (i = 0; i < from; i++)
+	if (redraw[i])
+	    mvaddstr(STATLINE, stats[i].st_col, stats[i].st_text);
+    if (from < NSTATS)
     {
-	temp = max_hp;
-	s_hp = max_hp;
-	for (hpwidth = 0; temp; hpwidth++)
-	    temp /= 10;
+	move(STATLINE, from == 0 ? 0 : stats[from - 1].st_end);
+	for (i = from; i < NSTATS; i++)
+	{
+	    if (i > 0)
+		addstr("  ");
+	    stats[i].st_col = getcurx(stdscr);
+	    addstr(stats[i].st_text);
+	    stats[i].st_end = getcurx(stdscr);
+	}
+	clrtoeol();
     }
+    stat_shown = TRUE;
+    move(oy, ox);
+}
 
-    /*
-     * Save current status
-     */
-    s_lvl = level;
-    s_pur = purse;
-    s_hp = pstats.s_hpt;
-    s_str = pstats.s_str;
-    s_exp = pstats.s_exp; 
-    s_hungry = hungry_state;
+/*
+ * wipe_status:
+ *	The screen has been cleared, so the whole status line has to be
+ *	drawn again
+ */
+void
+wipe_status()
+{
+    stat_shown = FALSE;
+}
 
-    if (stat_msg)
-    {
-	move(0, 0);
-        msg(msg_get("MSG_STATUS_FORMAT"),
-	    msg_get("MSG_LEVEL"), level, msg_get("MSG_GOLD"), purse,
-	    msg_get("MSG_HP"), hpwidth, pstats.s_hpt, hpwidth, max_hp,
-	    msg_get("MSG_STR"), pstats.s_str, max_stats.s_str,
-	    msg_get("MSG_ARM"), 10 - s_arm,
-	    msg_get("MSG_EXP"), pstats.s_lvl, pstats.s_exp,
-	    state_name[hungry_state]);
-    }
-    else
+/*
+ * The map part of the screen is kept in places[] as well as in curses.
+ * p_show is what the game wants to be on the screen at a spot, p_drawn
+ * is what curses was last handed for it.  Drawing only changes p_show
+ * and grows the dirty rectangle; flush_map() then sends curses just the
+ * spots inside it that really changed, and the game never has to ask
+ * curses what it put where.
+ */
+static int dirty_top = MAXLINES, dirty_bot = -1;
+static int dirty_left = MAXCOLS, dirty_right = -1;
+static long last_frame = 0;		/* When show_frame() last drew */
+
+/*
+ * What the screen and the messages are up to belongs to each game
+ */
+GAMEVAR io_vars[] = {
+    GV(msgbuf), GV(newpos), GV(msg_log), GV(nmsgs), GV(logging), GV(stats),
+    GV(stat_shown), GV(hpwidth), GV(dirty_top), GV(dirty_bot), GV(dirty_left), GV(dirty_right), GV(last_frame),
+    GV_END
+};
+
+/*
+ * mvshow:
+ *	Put a character on the map part of the screen
+ */
+void
+mvshow(int y, int x, chtype ch)
+{
+    PLACE *pp;
+
+    pp = INDEX(y, x);
+    if (pp->p_show == ch)
+	return;
+    pp->p_show = ch;
+    if (y < dirty_top)
+	dirty_top = y;
+    if (y > dirty_bot)
+	dirty_bot = y;
+    if (x < dirty_left)
+	dirty_left = x;
+    if (x > dirty_right)
+	dirty_right = x;
+}
+
+/*
+ * flush_map:
+ *	Send the spots of the map that changed since the last flush out
+ *	to curses.  Keep the cursor where it was.
+ */
+void
+flush_map()
+{
+    int y, x, oy, ox;
+    PLACE *pp;
+
+    if (stdscr == NULL || dirty_bot < 0)
+	return;
+    getyx(stdscr, oy, ox);
+    for (x = dirty_left; x <= dirty_right; x++)
+	for (y = dirty_top; y <= dirty_bot; y++)
+	{
+	    pp = INDEX(y, x);
+	    if (pp->p_drawn != pp->p_show)
+	    {
+		mvaddch(y, x, pp->p_show);
+		pp->p_drawn = pp->p_show;
+	    }
+	}
+    dirty_top = MAXLINES;
+    dirty_bot = -1;
+    dirty_left = MAXCOLS;
+    dirty_right = -1;
+    move(oy, ox);
+}
+
+/*
+ * show_frame:
+ *	Put the screen out.  While a run, a counted command or a fight to
+ *	the death is going on, frames that would come faster than
+ *	frame_rate a second are skipped; the next one that does go out
+ *	has everything in it anyway.  Nothing goes out at all when
+ *	nobody is watching.  Frames that go out are what a ttyrec
+ *	recording is made of.
+ */
+void
+show_frame()
+{
+    long now;
+
+    flush_map();
+    if (headless)
+	return;
+    if ((running || count || to_death) && frame_rate > 0)
     {
-	move(STATLINE, 0);
-
-        printw(msg_get("MSG_STATUS_FORMAT"),
-	    msg_get("MSG_LEVEL"), level, msg_get("MSG_GOLD"), purse,
-	    msg_get("MSG_HP"), hpwidth, pstats.s_hpt, hpwidth, max_hp,
-	    msg_get("MSG_STR"), pstats.s_str, max_stats.s_str,
-	    msg_get("MSG_ARM"), 10 - s_arm,
-	    msg_get("MSG_EXP"), pstats.s_lvl, pstats.s_exp,
-	    state_name[hungry_state]);
+	now = md_msecs();
+	if (now - last_frame < 1000L / frame_rate)
+	    return;
+	last_frame = now;
     }
+    refresh();
+    put_ttyrec(FALSE);
+    put_watch();
+}
 
-    clrtoeol();
-    move(oy, ox);
+/*
+ * sync_map:
+ *	Take the map from whatever curses has on the screen, for when
+ *	the screen was filled in behind our back (restoring a game)
+ */
+void
+sync_map()
+{
+    int y, x;
+    PLACE *pp;
+
+    for (x = 0; x < NUMCOLS; x++)
+	for (y = 1; y < NUMLINES - 1; y++)
+	{
+	    pp = INDEX(y, x);
+	    pp->p_show = pp->p_drawn = mvinch(y, x);
+	}
+    dirty_top = MAXLINES;
+    dirty_bot = -1;
+    dirty_left = MAXCOLS;
+    dirty_right = -1;
 }
 
 /*
@@ -267,6 +567,8 @@ wait_for(int ch)
 {
     register char c;
 
+    if (action != NULL)
+	return;
     if (ch == '\n')
         while ((c = readchar()) != '\n' && c != '\r')
 	    continue;
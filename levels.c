@@ -0,0 +1,511 @@
+/*
+ * Keep levels that have been dug, so that asking for the same level
+ * again (same dungeon, same depth, same state of the hero's luck)
+ * hands back a copy instead of digging it all over.  This is for
+ * playing the same seeds over and over, as when testing players;
+ * a normal game never asks for the same level twice.
+ *
+ * Rogue: Exploring the Dungeons of Doom
+ * Copyright (C) 1980-1983, 1985, 1999 Michael Toy, Ken Arnold and Glenn Wichman
+ * All rights reserved.
+ *
+ * See the file LICENSE.TXT for full copyright and licensing information.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <curses.h>
+#include "rogue.h"
+
+#define MAXCACHE	32	/* Levels kept in memory */
+
+/*
+ * A level as it stands just after it is dug
+ */
+typedef struct {
+    bool lv_used;			/* This slot holds a level */
+    LEVKEY lv_key;			/* What it was dug from */
+    char lv_ch[MAXLINES*MAXCOLS];	/* What is at each spot */
+    char lv_flags[MAXLINES*MAXCOLS];	/* And the flags of each spot */
+    unsigned char lv_pnum[MAXLINES*MAXCOLS];	/* And its passage number */
+    struct room lv_rooms[MAXROOMS];
+    struct room lv_pass[MAXPASS];
+    THING *lv_obj;			/* Things lying around */
+    THING *lv_mlist;			/* Monsters, and their packs */
+    coord lv_stairs;
+    int lv_ntraps;
+    int lv_food;			/* no_food after digging */
+    int lv_group0, lv_group1;		/* group before and after digging */
+    RNG lv_rng;				/* Level stream after digging */
+} LEVEL;
+
+static LEVEL cache[MAXCACHE];
+static int next_slot = 0;		/* Where the next one goes */
+static LEVKEY cur_key;			/* Key of the level being made */
+static int cur_group;			/* group when it was started */
+static LEVKEY ahead_key;		/* Key of the last level dug ahead */
+
+GAMEVAR levels_vars[] = {		/* The cache itself is shared */
+    GV(cur_key), GV(cur_group), GV(ahead_key),
+    GV_END
+};
+
+/*
+ * make_key:
+ *	Work out what the level about to be dug depends on
+ */
+
+static void
+make_key(LEVKEY *kp)
+{
+    memset(kp, 0, sizeof *kp);
+    kp->k_rng = *rng;
+    kp->k_level = level;
+    kp->k_food = no_food;
+    if (amulet)
+    {
+	kp->k_flags |= LK_AMULET;
+	if (level < max_level)
+	    kp->k_flags |= LK_OLD;
+    }
+    if (ISWEARING(R_AGGR))
+	kp->k_flags |= LK_AGGR;
+}
+
+/*
+ * same_key:
+ *	Would these two keys dig the same level
+ */
+
+bool
+same_key(LEVKEY *k1, LEVKEY *k2)
+{
+    return (k1->k_rng.r_kind == k2->k_rng.r_kind
+	&& k1->k_rng.r_seed == k2->k_rng.r_seed
+	&& k1->k_rng.r_key == k2->k_rng.r_key
+	&& k1->k_rng.r_state == k2->k_rng.r_state
+	&& k1->k_level == k2->k_level
+	&& k1->k_food == k2->k_food
+	&& k1->k_flags == k2->k_flags);
+}
+
+/*
+ * copy_things:
+ *	Make a copy of a list of things, in the same order
+ */
+
+static THING *
+copy_things(THING *list)
+{
+    THING *head = NULL, *tail = NULL, *tp, *np;
+
+    for (tp = list; tp != NULL; tp = next(tp))
+    {
+	np = new_item();
+	*np = *tp;
+	np->l_next = NULL;
+	np->l_prev = tail;
+	if (tail == NULL)
+	    head = np;
+	else
+	    tail->l_next = np;
+	tail = np;
+    }
+    return head;
+}
+
+/*
+ * move_dest:
+ *	Find where a monster running to something in one copy of a
+ *	level is running to in another copy of it
+ */
+
+static coord *
+move_dest(coord *dest, THING *objs, THING *to_objs, THING *mons,
+    THING *to_mons)
+{
+    for (; objs != NULL; objs = next(objs), to_objs = next(to_objs))
+	if (dest == &objs->o_pos)
+	    return &to_objs->o_pos;
+    for (; mons != NULL; mons = next(mons), to_mons = next(to_mons))
+	if (dest == &mons->t_pos)
+	    return &to_mons->t_pos;
+    return dest;			/* the hero, gold, or nowhere */
+}
+
+/*
+ * copy_lists:
+ *	Copy the things and monsters on a level, keeping the monsters
+ *	running to what they were running to
+ */
+
+static void
+copy_lists(THING *objs, THING *mons, THING **to_objs, THING **to_mons)
+{
+    THING *tp, *np;
+
+    *to_objs = copy_things(objs);
+    *to_mons = copy_things(mons);
+    for (tp = mons, np = *to_mons; tp != NULL; tp = next(tp), np = next(np))
+    {
+	np->t_pack = copy_things(tp->t_pack);
+	np->t_rnext = NULL;
+	np->t_rprev = NULL;
+	np->t_dest = move_dest(tp->t_dest, objs, *to_objs, mons, *to_mons);
+    }
+}
+
+/*
+ * drop_lists:
+ *	Throw away a list of monsters and their packs, and a list of
+ *	things
+ */
+
+static void
+drop_lists(THING **objs, THING **mons)
+{
+    THING *tp;
+
+    for (tp = *mons; tp != NULL; tp = next(tp))
+	free_list(tp->t_pack);
+    _free_list(mons);
+    _free_list(objs);
+}
+
+/*
+ * regroup:
+ *	Renumber the groups of missiles dug with a level, now that it is
+ *	dug with group at cur_group instead of at first
+ */
+
+static void
+regroup(int first, int last)
+{
+    THING *obj, *tp;
+    int delta;
+
+    delta = cur_group - first;
+    for (obj = lvl_obj; obj != NULL; obj = next(obj))
+	if (obj->o_group != 0)
+	    obj->o_group += delta;
+    for (tp = mlist; tp != NULL; tp = next(tp))
+	for (obj = tp->t_pack; obj != NULL; obj = next(obj))
+	    if (obj->o_group != 0)
+		obj->o_group += delta;
+    group = last + delta;
+}
+
+/*
+ * index_level:
+ *	Point the map at the monsters and things of a level just put back
+ */
+
+static void
+index_level()
+{
+    THING *tp;
+
+    for (tp = mlist; tp != NULL; tp = next(tp))
+	moat(tp->t_pos.y, tp->t_pos.x) = tp;
+    index_objs();
+    index_rooms();
+}
+
+/*
+ * level_file:
+ *	Name of the file a level with this key is kept in
+ */
+
+static char *
+level_file(LEVKEY *kp)
+{
+    static char path[2*MAXSTR];
+    uint64_t h;
+
+    h = kp->k_rng.r_key ^ (kp->k_rng.r_state * 0x9e3779b97f4a7c15ULL)
+	^ ((uint64_t) (unsigned int) kp->k_rng.r_seed << 8)
+	^ ((uint64_t) (kp->k_food * 8 + kp->k_flags) << 40)
+	^ (uint64_t) kp->k_rng.r_kind;
+    h ^= h >> 32;
+    sprintf(path, "%.*s/rogue-%d-%08x.lvl", MAXSTR, cache_dir, kp->k_level,
+	(unsigned int) (h & 0xffffffff));
+    return path;
+}
+
+/*
+ * read_level:
+ *	Try to put back a level kept on disk
+ */
+
+static bool
+read_level()
+{
+    FILE *inf;
+    int first, last;
+    PLACE *pp;
+
+    if ((inf = fopen(level_file(&cur_key), "rb")) == NULL)
+	return FALSE;
+    if (rs_read_level(inf, &cur_key, &first, &last) != 0)
+    {
+	fclose(inf);
+	/*
+	 * Whatever got read in before it went wrong has to go
+	 */
+	drop_lists(&lvl_obj, &mlist);
+	for (pp = places; pp < &places[MAXCOLS*MAXLINES]; pp++)
+	{
+	    pp->p_ch = ' ';
+	    pp->p_flags = F_REAL;
+	    pp->p_pnum = 0;
+	    pp->p_monst = NULL;
+	    pp->p_obj = NULL;
+	    pp->p_show = pp->p_drawn = ' ';
+	}
+	return FALSE;
+    }
+    fclose(inf);
+    regroup(first, last);
+    index_level();
+    return TRUE;
+}
+
+/*
+ * write_level:
+ *	Keep the level just dug on disk too.  It is written to a file of
+ *	its own and only renamed into place once all of it is there, so
+ *	a write that is cut short never leaves half a level to be read.
+ */
+
+static void
+write_level()
+{
+    static char tmp[2*MAXSTR + 16];
+    FILE *savef;
+    char *path;
+    int err;
+
+    path = level_file(&cur_key);
+    sprintf(tmp, "%s.%d", path, md_getpid());
+    if ((savef = fopen(tmp, "wb")) == NULL)
+	return;
+    err = rs_write_level(savef, &cur_key, cur_group);
+    if (fclose(savef) != 0 || err != 0 || rename(tmp, path) != 0)
+	md_unlink(tmp);
+}
+
+/*
+ * save_level:
+ *	Put the level just dug in the memory cache, pushing out the
+ *	oldest one if it is full
+ */
+
+static void
+save_level()
+{
+    LEVEL *lp;
+    PLACE *pp;
+    int i;
+
+    lp = &cache[next_slot];
+    next_slot = (next_slot + 1) % MAXCACHE;
+    if (lp->lv_used)
+	drop_lists(&lp->lv_obj, &lp->lv_mlist);
+    lp->lv_used = TRUE;
+    lp->lv_key = cur_key;
+    for (pp = places, i = 0; pp < &places[MAXCOLS*MAXLINES]; pp++, i++)
+    {
+	lp->lv_ch[i] = pp->p_ch;
+	lp->lv_flags[i] = pp->p_flags;
+	lp->lv_pnum[i] = pp->p_pnum;
+    }
+    memcpy(lp->lv_rooms, rooms, sizeof lp->lv_rooms);
+    memcpy(lp->lv_pass, passages, sizeof lp->lv_pass);
+    copy_lists(lvl_obj, mlist, &lp->lv_obj, &lp->lv_mlist);
+    lp->lv_stairs = stairs;
+    lp->lv_ntraps = ntraps;
+    lp->lv_food = no_food;
+    lp->lv_group0 = cur_group;
+    lp->lv_group1 = group;
+    lp->lv_rng = *rng;
+}
+
+/*
+ * put_level:
+ *	Put a kept level back as the current one
+ */
+
+static void
+put_level(LEVEL *lp)
+{
+    PLACE *pp;
+    int i;
+
+    for (pp = places, i = 0; pp < &places[MAXCOLS*MAXLINES]; pp++, i++)
+    {
+	pp->p_ch = lp->lv_ch[i];
+	pp->p_flags = lp->lv_flags[i];
+	pp->p_pnum = lp->lv_pnum[i];
+    }
+    memcpy(rooms, lp->lv_rooms, sizeof lp->lv_rooms);
+    memcpy(passages, lp->lv_pass, sizeof lp->lv_pass);
+    copy_lists(lp->lv_obj, lp->lv_mlist, &lvl_obj, &mlist);
+    stairs = lp->lv_stairs;
+    ntraps = lp->lv_ntraps;
+    no_food = lp->lv_food;
+    *rng = lp->lv_rng;
+    regroup(lp->lv_group0, lp->lv_group1);
+    index_level();
+}
+
+/*
+ * load_level:
+ *	If the level about to be dug has been dug before, put it back
+ *	and return TRUE.  The map, monster list and object list must
+ *	already be empty.
+ */
+
+bool
+load_level()
+{
+    LEVEL *lp;
+
+    make_key(&cur_key);
+    cur_group = group;
+    if (!level_cache && !pre_dig)
+	return FALSE;
+    for (lp = cache; lp < &cache[MAXCACHE]; lp++)
+	if (lp->lv_used && same_key(&lp->lv_key, &cur_key))
+	{
+	    put_level(lp);
+	    return TRUE;
+	}
+    if (cache_dir[0] != '\0' && read_level())
+    {
+	save_level();
+	return TRUE;
+    }
+    return FALSE;
+}
+
+/*
+ * keep_level:
+ *	Keep the level just dug, in case it is asked for again
+ */
+
+void
+keep_level()
+{
+    if (!level_cache && !pre_dig)
+	return;
+    save_level();
+    if (cache_dir[0] != '\0')
+	write_level();
+}
+
+/*
+ * dig_ahead:
+ *	While waiting for the player, dig the level below this one and
+ *	keep it, so going down the stairs only has to put it back.
+ *	This level is put back just as it was.  It takes the fast
+ *	generator, since only then is it known ahead of time what the
+ *	level below will be dug from.  Nor is it done while the hero
+ *	aggravates monsters: they would be set running as they were
+ *	made, taking numbers from this level's monster stream.
+ */
+
+void
+dig_ahead()
+{
+    static PLACE here[MAXLINES*MAXCOLS];
+    static struct room here_rooms[MAXROOMS], here_pass[MAXPASS];
+    THING *objs, *mons;
+    PLACE *pp;
+    RNG lstream;
+    LEVKEY key;
+    coord st;
+    int lev, maxlev, nt, food, grp, seq, ors;
+
+    if (!pre_dig || streams[RS_MAIN].r_kind == RNG_LEGACY
+	|| ISWEARING(R_AGGR))
+	return;
+    lev = level;
+    maxlev = max_level;
+    lstream = streams[RS_LEVEL];
+    if (++level > max_level)
+	max_level = level;
+    rng_level(level);
+    ors = rng_use(RS_LEVEL);
+    make_key(&key);
+    if (!same_key(&key, &ahead_key))
+    {
+	ahead_key = key;
+	/*
+	 * Put this level aside and dig the next one in its place
+	 */
+	memcpy(here, places, sizeof here);
+	memcpy(here_rooms, rooms, sizeof here_rooms);
+	memcpy(here_pass, passages, sizeof here_pass);
+	objs = lvl_obj;
+	mons = mlist;
+	st = stairs;
+	nt = ntraps;
+	food = no_food;
+	grp = group;
+	seq = mon_seq;
+	lvl_obj = NULL;
+	mlist = NULL;
+	for (pp = places; pp < &places[MAXCOLS*MAXLINES]; pp++)
+	{
+	    pp->p_ch = ' ';
+	    pp->p_flags = F_REAL;
+	    pp->p_pnum = 0;
+	    pp->p_monst = NULL;
+	    pp->p_obj = NULL;
+	    pp->p_show = pp->p_drawn = ' ';
+	}
+	index_rooms();
+	if (!load_level())
+	{
+	    dig_level();
+	    keep_level();
+	}
+	/*
+	 * The cache has it now, so put this level back
+	 */
+	drop_lists(&lvl_obj, &mlist);
+	memcpy(places, here, sizeof here);
+	memcpy(rooms, here_rooms, sizeof here_rooms);
+	memcpy(passages, here_pass, sizeof here_pass);
+	lvl_obj = objs;
+	mlist = mons;
+	stairs = st;
+	ntraps = nt;
+	no_food = food;
+	group = grp;
+	mon_seq = seq;
+    }
+    rng_use(ors);
+    streams[RS_LEVEL] = lstream;
+    level = lev;
+    max_level = maxlev;
+}
+
+/*
+ * flush_levels:
+ *	Forget all the levels kept in memory
+ */
+
+void
+flush_levels()
+{
+    LEVEL *lp;
+
+    for (lp = cache; lp < &cache[MAXCACHE]; lp++)
+	if (lp->lv_used)
+	{
+	    drop_lists(&lp->lv_obj, &lp->lv_mlist);
+	    lp->lv_used = FALSE;
+	}
+    next_slot = 0;
+}
@@ -59,6 +59,77 @@ _attach(THING **list, THING *item)
     *list = item;
 }
 
+/*
+ * attach_obj:
+ *	Put an object down on the level at its o_pos, keeping the
+ *	per-spot object index in step with lvl_obj.  The objects on a
+ *	spot are chained through o_under in the order lvl_obj has them.
+ */
+
+void
+attach_obj(THING *obj)
+{
+    attach(lvl_obj, obj);
+    obj->o_under = obat(obj->o_pos.y, obj->o_pos.x);
+    obat(obj->o_pos.y, obj->o_pos.x) = obj;
+}
+
+/*
+ * detach_obj:
+ *	Take an object off the level.  There is normally only one object
+ *	to a spot, but if another one was stacked underneath it, that one
+ *	becomes the object at the spot.
+ */
+
+void
+detach_obj(THING *obj)
+{
+    THING **opp;
+
+    detach(lvl_obj, obj);
+    for (opp = &obat(obj->o_pos.y, obj->o_pos.x); *opp != NULL;
+	opp = &(*opp)->o_under)
+	    if (*opp == obj)
+	    {
+		*opp = obj->o_under;
+		break;
+	    }
+    obj->o_under = NULL;
+}
+
+/*
+ * index_objs:
+ *	Rebuild the per-spot object index from lvl_obj, and the claims
+ *	monsters have on those objects from where they are running to
+ */
+
+void
+index_objs()
+{
+    PLACE *pp;
+    THING *obj, *tp, **opp;
+
+    for (pp = places; pp < &places[MAXCOLS*MAXLINES]; pp++)
+	pp->p_obj = NULL;
+    for (obj = lvl_obj; obj != NULL; obj = next(obj))
+    {
+	obj->o_claim = NULL;
+	obj->o_under = NULL;
+	for (opp = &obat(obj->o_pos.y, obj->o_pos.x); *opp != NULL;
+	    opp = &(*opp)->o_under)
+		continue;
+	*opp = obj;
+    }
+    for (tp = mlist; tp != NULL; tp = next(tp))
+    {
+	if (tp->t_dest == NULL)
+	    continue;
+	obj = obat(tp->t_dest->y, tp->t_dest->x);
+	if (obj != NULL && &obj->o_pos == tp->t_dest)
+	    obj->o_claim = tp;
+    }
+}
+
 /*
  * _free_list:
  *	Throw the whole blamed thing away
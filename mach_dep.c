@@ -460,5 +460,8 @@ unlock_sc()
 void
 flush_type()
 {
-    flushinp();
+    if (serving)
+	session_flush();
+    else
+	md_flushinp();
 }
@@ -25,9 +25,6 @@
 int
 main(int argc, char **argv, char **envp)
 {
-    char *env;
-    int lowtime;
-
     setlocale(LC_ALL, "");
     md_init();
 
@@ -59,18 +56,13 @@ main(int argc, char **argv, char **envp)
     strcpy(file_name, home);
     strcat(file_name, "rogue.save");
 
-    if ((env = getenv("ROGUEOPTS")) != NULL)
-	parse_opts(env);
-    if (env == NULL || whoami[0] == '\0')
-        strucpy(whoami, md_getusername(), (int) strlen(md_getusername()));
-    lowtime = (int) time(NULL);
-#ifdef MASTER
-    if (wizard && getenv("SEED") != NULL)
-	dnum = atoi(getenv("SEED"));
-    else
-#endif
-	dnum = lowtime + md_getpid();
-    seed = dnum;
+    /*
+     * Watching someone else's game takes nothing of our own
+     */
+    if (argc == 3 && strcmp(argv[1], "-w") == 0)
+	exit(watch(argv[2]) ? 0 : 1);
+    if ((argc = init_seed(argc, argv)) < 0)
+	exit(1);
 
     open_score();
 
@@ -109,40 +101,32 @@ main(int argc, char **argv, char **envp)
     }
 
     init_check();			/* check for legal startup */
+    /*
+     * A server plays its games over sockets, not on this terminal
+     */
+    if (argc >= 3 && strcmp(argv[1], "-S") == 0)
+    {
+	serve(argv[2], argc > 3 ? atoi(argv[3]) : 0);
+	exit(0);
+    }
     if (argc == 2)
 	if (!restore(argv[1], envp))	/* Note: restore will never return */
 	    my_exit(1);
-#ifdef MASTER
-    if (wizard)
-	printf(msg_get("MSG_HELLO_WIZARD"), whoami, dnum);
+    if (replaying)
+	replay_screen();		/* Nobody watches a replay */
     else
+    {
+#ifdef MASTER
+	if (wizard)
+	    printf(msg_get("MSG_HELLO_WIZARD"), whoami, dnum);
+	else
 #endif
-	printf(msg_get("MSG_HELLO_DIGGING"), whoami);
-    fflush(stdout);
-
-    initscr();				/* Start up cursor package */
-    init_probs();			/* Set up prob tables for objects */
-    init_player();			/* Set up initial player stats */
-    init_names();			/* Set up names of scrolls */
-    init_rainbow();			/* Initialize rainbow with translated colors */
-    init_colors();			/* Set up colors of potions */
-    init_stones_array();		/* Initialize stones with translated names */
-    init_stones();			/* Set up stone settings of rings */
-    init_wood_array();			/* Initialize wood with translated names */
-    init_metal_array();			/* Initialize metal with translated names */
-    init_materials();			/* Set up materials of wands */
-    init_monsters();			/* Initialize monster names */
-    init_potions();			/* Initialize potion effect names */
-    init_scrolls();			/* Initialize scroll effect names */
-    init_rings();			/* Initialize ring effect names */
-    init_sticks();			/* Initialize wand/staff effect names */
-    init_armors();                      /* Initialize armor names */
-    init_weapons();                     /* Initialize weapon names */
-    init_inv_t_name();			/* Initialize inventory type names */
-    init_options();			/* Initialize option prompt strings */
-    init_fruit();			/* Initialize default fruit name */
-    init_traps();			/* Set up trap names */
-    init_help();			/* Set up help strings */
+	    printf(msg_get("MSG_HELLO_DIGGING"), whoami);
+	fflush(stdout);
+	initscr();			/* Start up cursor package */
+    }
+    init_tables();			/* Set up what every game shares */
+    init_game();			/* Set up this game */
     setup();
 
     /*
@@ -155,6 +139,19 @@ main(int argc, char **argv, char **envp)
 	my_exit(1);
     }
 
+    start_game();
+    return(0);
+}
+
+/*
+ * start_game:
+ *	Set up the windows, dig the first level, start the daemons and
+ *	play a new game
+ */
+
+void
+start_game()
+{
     /*
      * Set up windows
      */
@@ -173,7 +170,6 @@ main(int argc, char **argv, char **envp)
     fuse(swander, 0, WANDERTIME, AFTER);
     start_daemon(stomach, 0, AFTER);
     playit();
-    return(0);
 }
 
 
@@ -255,25 +251,35 @@ playit()
     char *opts;
 
     /*
-     * set up defaults for slow terminals
+     * A replay sets things up just as the recorded game had them
      */
-
-    if (baudrate() <= 1200)
+    if (replaying)
+	replay_opts();
+    else
     {
-	terse = TRUE;
-	jump = TRUE;
-	see_floor = FALSE;
-    }
+	/*
+	 * set up defaults for slow terminals
+	 */
 
-    if (md_hasclreol())
-	inv_type = INV_CLEAR;
+	if (baudrate() <= 1200)
+	{
+	    terse = TRUE;
+	    jump = TRUE;
+	    see_floor = FALSE;
+	}
 
-    /*
-     * parse environment declaration of options
-     */
-    if ((opts = getenv("ROGUEOPTS")) != NULL)
-	parse_opts(opts);
+	if (md_hasclreol())
+	    inv_type = INV_CLEAR;
 
+	/*
+	 * parse environment declaration of options
+	 */
+	if ((opts = getenv("ROGUEOPTS")) != NULL)
+	    parse_opts(opts);
+	if (serving)
+	    no_files();
+    }
+    start_record();
 
     oldpos = hero;
     oldrp = roomin(&hero);
@@ -356,6 +362,15 @@ leave(int sig)
 void
 shell()
 {
+    /*
+     * There is no shell for players on a server to have
+     */
+    if (serving)
+    {
+	msg(msg_get("MSG_SERVER_NO_SHELL"));
+	after = FALSE;
+	return;
+    }
     /*
      * Set the terminal back to original mode
      */
@@ -368,9 +383,10 @@ shell()
     after = FALSE;
     fflush(stdout);
     /*
-     * Fork and do a shell
+     * Fork and do a shell, but not in a replay
      */
-    md_shellescape();
+    if (!replaying)
+	md_shellescape();
 
     printf("\n%s", msg_get("MSG_MAIN_PRESS_RETURN"));
     fflush(stdout);
@@ -391,6 +407,13 @@ shell()
 void
 my_exit(int st)
 {
+    if (serving)
+	session_end();
+    if (replaying)
+	end_replay(FALSE);
+    end_record();
+    end_ttyrec();
+    end_watch();
     resetltchars();
     exit(st);
 }
@@ -94,6 +94,12 @@
 #include <sys/wait.h>
 #endif
 
+#if !defined(_WIN32)
+#include <sys/time.h>
+#include <poll.h>
+#include <errno.h>
+#endif
+
 #include <ctype.h>
 #include <fcntl.h>
 #include <limits.h>
@@ -507,6 +513,19 @@ md_gethomedir()
     return(homedir);
 }
 
+long
+md_msecs()
+{
+#ifdef _WIN32
+    return (long) GetTickCount();
+#else
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000L + tv.tv_usec / 1000;
+#endif
+}
+
 void
 md_sleep(int s)
 {
@@ -517,6 +536,16 @@ md_sleep(int s)
 #endif
 }
 
+void
+md_msleep(int ms)
+{
+#ifdef _WIN32
+    Sleep(ms);
+#else
+    usleep(ms * 1000L);
+#endif
+}
+
 char *
 md_getshell()
 {
@@ -804,7 +833,9 @@ md_setsuspchar(int c)
     limitations of those terminal capability databases.
 
     I give curses first crack at decoding the sequences. If it fails to decode
-    it we check for common ESC-prefixed sequences.
+    it we check for common ESC-prefixed sequences.  (Away from Windows the
+    sequences curses would know are looked up in terminfo instead, and
+    both kinds are decoded here; see md_keydecode() below.)
 
     All cursor/keypad results are translated into standard rogue movement 
     commands.
@@ -1072,6 +1103,242 @@ md_setsuspchar(int c)
     ESC Ou,	ESC Ou,		ESC Ou,	    O		    /# Keypad 5	    #/
 */
 
+/*
+ * Everywhere but Windows, keys are not read from curses one at a time.
+ * Whatever the terminal has sent is read in one go into kb_buf, and the
+ * sequences that cursor and keypad keys send are picked out of it with
+ * a trie: first the ones terminfo knows for this terminal, then the
+ * ESC-prefixed ones from the tables above that curses never knew.  A
+ * burst of typing or a paste is taken apart in one pass, and an ESC
+ * only waits for the rest of a sequence when nothing follows it yet.
+ */
+
+#define KB_BUFSIZ	256		/* Bytes read ahead of the game */
+#define KB_WAIT		100		/* Milliseconds to wait for the rest */
+#define KB_NODES	512		/* Room in the trie */
+
+typedef struct {
+    unsigned char kn_byte;		/* What leads here from above */
+    short kn_child;			/* First node below, or -1 */
+    short kn_sibling;			/* Next node beside it, or -1 */
+    short kn_key;			/* What the bytes so far mean, or -1 */
+} KEYNODE;
+
+static KEYNODE key_trie[KB_NODES];	/* Node 0 is the root */
+static int key_nodes = 0;		/* How many are in use */
+
+/*
+ * What terminfo keys mean, and what they mean after another ESC
+ */
+static struct {
+    char *kc_cap;
+    int kc_key, kc_meta;
+} key_caps[] = {
+    { "kcub1",	'h',		CTRL('H') },	/* Left */
+    { "kcud1",	'j',		CTRL('J') },	/* Down */
+    { "kcuu1",	'k',		CTRL('K') },	/* Up */
+    { "kcuf1",	'l',		CTRL('L') },	/* Right */
+    { "khome",	'y',		CTRL('Y') },	/* Home */
+    { "kpp",	'u',		CTRL('U') },	/* Page Up */
+    { "knp",	'n',		CTRL('N') },	/* Page Down */
+    { "kend",	'b',		CTRL('B') },	/* End */
+    { "kll",	'b',		0 },		/* Home Down */
+    { "ka1",	'y',		0 },		/* Keypad Home */
+    { "ka3",	'u',		0 },		/* Keypad PgUp */
+    { "kb2",	'u',		0 },		/* Keypad 5, as PuTTY needs */
+    { "kc1",	'b',		0 },		/* Keypad End */
+    { "kc3",	'n',		0 },		/* Keypad PgDn */
+    { "kLFT",	CTRL('H'),	0 },		/* Shift-Left */
+    { "kRIT",	CTRL('L'),	0 },		/* Shift-Right */
+    { "kri",	CTRL('K'),	0 },		/* Shift-Up */
+    { "kind",	CTRL('J'),	0 },		/* Shift-Down */
+    { "kHOM",	CTRL('Y'),	0 },		/* Shift-Home */
+    { "kPRV",	CTRL('U'),	0 },		/* Shift-PgUp */
+    { "kNXT",	CTRL('N'),	0 },		/* Shift-PgDn */
+    { "kEND",	CTRL('B'),	0 },		/* Shift-End */
+    { "kel",	CTRL('B'),	0 },		/* Clear to End of Line */
+    { "kbs",	CTRL('H'),	0 },		/* Backspace */
+    { NULL,	0,		0 }
+};
+
+/*
+ * What follows ESC F, ESC O or ESC [ (see the tables above)
+ */
+static struct {
+    char kp_byte;
+    int kp_key;
+} key_pads[] = {
+    { '^', CTRL('H') }, { '$', CTRL('L') },		/* Interix */
+    { 'H', 'y' }, { 1, CTRL('K') }, { 2, CTRL('J') },
+    { 3, CTRL('L') }, { 4, CTRL('H') }, { 19, CTRL('U') },
+    { 20, CTRL('N') }, { 21, CTRL('B') },
+    { 'G', '.' },					/* Cygwin */
+    { 'D', CTRL('H') }, { 'C', CTRL('L') },		/* PuTTY */
+    { 'A', CTRL('K') }, { 'B', CTRL('J') },
+    { 't', 'h' }, { 'v', 'l' }, { 'x', 'k' }, { 'r', 'j' },
+    { 'w', 'y' }, { 'y', 'u' }, { 's', 'n' }, { 'q', 'b' },
+    { 'u', '.' },
+    { '\0', 0 }
+};
+
+/*
+ * And the ones ended by ~ or ^, with the key they stand for
+ */
+static struct {
+    char kt_byte;
+    int kt_key;
+} key_trails[] = {
+    { '7', 'Y' }, { '5', 'U' }, { '6', 'N' },		/* Cygwin, MSYS */
+    { '1', 'y' }, { '4', 'b' },				/* Telnet, PuTTY */
+    { '\0', 0 }
+};
+
+/*
+ * key_child:
+ *	The node below node that byte leads to, or -1
+ */
+
+static int
+key_child(int node, int byte)
+{
+    for (node = key_trie[node].kn_child; node >= 0; node = key_trie[node].kn_sibling)
+	if (key_trie[node].kn_byte == byte)
+	    break;
+    return node;
+}
+
+/*
+ * key_add:
+ *	Put a sequence into the trie, unless it already means something
+ */
+
+static void
+key_add(const char *seq, int key)
+{
+    int node, next;
+
+    if (seq == NULL || seq == (char *) -1 || *seq == '\0')
+	return;
+    for (node = 0; *seq != '\0'; seq++, node = next)
+	if ((next = key_child(node, (unsigned char) *seq)) < 0)
+	{
+	    if (key_nodes == KB_NODES)
+		return;
+	    next = key_nodes++;
+	    key_trie[next].kn_byte = (unsigned char) *seq;
+	    key_trie[next].kn_child = -1;
+	    key_trie[next].kn_key = -1;
+	    key_trie[next].kn_sibling = key_trie[node].kn_child;
+	    key_trie[node].kn_child = (short) next;
+	}
+    if (key_trie[node].kn_key < 0)
+	key_trie[node].kn_key = (short) key;
+}
+
+/*
+ * key_init:
+ *	Fill in the trie
+ */
+
+static void
+key_init()
+{
+    char seq[MAXSTR], *cap;
+    int i, j, key;
+    const char *pad, *lead;
+
+    key_trie[0].kn_child = -1;
+    key_trie[0].kn_sibling = -1;
+    key_trie[0].kn_key = -1;
+    key_nodes = 1;
+#ifndef _WIN32
+    for (i = 0; key_caps[i].kc_cap != NULL; i++)
+    {
+	cap = tigetstr(key_caps[i].kc_cap);
+	if (cap == NULL || cap == (char *) -1 || strlen(cap) + 2 > sizeof seq)
+	    continue;
+	key_add(cap, key_caps[i].kc_key);
+	if (key_caps[i].kc_meta != 0)
+	{
+	    sprintf(seq, "\033%s", cap);
+	    key_add(seq, key_caps[i].kc_meta);
+	}
+    }
+#endif
+    for (lead = "\033\0\033\033\0"; *lead != '\0'; lead += strlen(lead) + 1)
+	for (pad = "FO["; *pad != '\0'; pad++)
+	{
+	    for (i = 0; key_pads[i].kp_byte != '\0'; i++)
+	    {
+		sprintf(seq, "%s%c%c", lead, *pad, key_pads[i].kp_byte);
+		key_add(seq, key_pads[i].kp_key);
+	    }
+	    for (i = 0; key_trails[i].kt_byte != '\0'; i++)
+		for (j = 0; j < 2; j++)
+		{
+		    sprintf(seq, "%s%c%c%c", lead, *pad, key_trails[i].kt_byte,
+			"~^"[j]);
+		    key = key_trails[i].kt_key;
+		    key = (j == 0 ? tolower(key) : CTRL(toupper(key)));
+		    if (lead[1] != '\0')
+			key = CTRL(toupper(key));
+		    key_add(seq, key);
+		}
+	}
+}
+
+/*
+ * md_keydecode:
+ *	Make out the key that the len bytes at buf start with, and set
+ *	*used to how many bytes it took.  If they could be the start of
+ *	a longer sequence and more may still come, returns -1 instead.
+ *	A sequence nobody knows stands for the byte it went wrong at,
+ *	and one cut short for ESC.
+ */
+
+int
+md_keydecode(const unsigned char *buf, int len, int *used, bool more)
+{
+    int i, node, key;
+
+    if (key_nodes == 0)
+	key_init();
+    key = -1;
+    *used = 1;
+    node = 0;
+    for (i = 0; i < len; i++)
+    {
+	if ((node = key_child(node, buf[i])) < 0)
+	    break;
+	if (key_trie[node].kn_key >= 0)
+	{
+	    key = key_trie[node].kn_key;
+	    *used = i + 1;
+	}
+    }
+    if (node >= 0 && key_trie[node].kn_child >= 0 && more)
+	return -1;
+    if (key >= 0)
+	return key;
+    if (buf[0] != '\033')
+	return buf[0];
+    if (i == len)
+    {
+	*used = len;
+	return '\033';
+    }
+    *used = i + 1;
+    return buf[i];
+}
+
+#ifdef _WIN32
+
+void
+md_flushinp()
+{
+    flushinp();
+}
+
 #define M_NORMAL 0
 #define M_ESC    1
 #define M_KEYPAD 2
@@ -1317,6 +1584,96 @@ md_readchar()
     return(ch & 0x7F);
 }
 
+#else
+
+static unsigned char kb_buf[KB_BUFSIZ];	/* What the terminal has sent */
+static int kb_pos = 0;			/* Where the next key starts */
+static int kb_len = 0;			/* And where what was sent ends */
+
+/*
+ * kb_fill:
+ *	Read whatever the terminal has sent into kb_buf, waiting ms
+ *	milliseconds for something if there is nothing, or for as long
+ *	as it takes if ms is negative.  Returns whether anything came.
+ */
+
+static bool
+kb_fill(int ms)
+{
+    struct pollfd pfd;
+    ssize_t n;
+    int fd = fileno(stdin);
+
+    if (kb_pos > 0)
+    {
+	memmove(kb_buf, &kb_buf[kb_pos], kb_len - kb_pos);
+	kb_len -= kb_pos;
+	kb_pos = 0;
+    }
+    if (kb_len == KB_BUFSIZ)
+	return FALSE;
+    if (ms >= 0)
+    {
+	pfd.fd = fd;
+	pfd.events = POLLIN;
+	if (poll(&pfd, 1, ms) <= 0)
+	    return FALSE;
+    }
+    do
+	n = read(fd, &kb_buf[kb_len], KB_BUFSIZ - kb_len);
+    while (n < 0 && errno == EINTR);
+    if (n <= 0)
+	return FALSE;
+    kb_len += (int) n;
+    return TRUE;
+}
+
+/*
+ * md_flushinp:
+ *	Throw away the keys typed ahead
+ */
+
+void
+md_flushinp()
+{
+    kb_pos = kb_len = 0;
+    flushinp();
+}
+
+int
+md_readchar()
+{
+    int key, used, y, x, cy, cx;
+
+    for (;;)
+    {
+	if (kb_pos == kb_len)
+	{
+	    /*
+	     * Bring the screen up to date before waiting, as getch()
+	     * would have
+	     */
+	    getyx(stdscr, y, x);
+	    getyx(curscr, cy, cx);
+	    if (is_wintouched(stdscr) || y != cy || x != cx)
+		refresh();
+	    if (!kb_fill(-1))
+		return '\033';		/* the terminal has gone away */
+	}
+	key = md_keydecode(&kb_buf[kb_pos], kb_len - kb_pos, &used, TRUE);
+	if (key < 0 && !kb_fill(KB_WAIT))
+	    key = md_keydecode(&kb_buf[kb_pos], kb_len - kb_pos, &used, FALSE);
+	if (key >= 0)
+	{
+	    kb_pos += used;
+	    return key & 0x7F;
+	}
+    }
+}
+
+#endif
+
+
 #if defined(LOADAV) && defined(HAVE_NLIST_H) && defined(HAVE_NLIST)
 /*
  * loadav:
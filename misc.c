@@ -19,6 +19,13 @@
 #include "i18n.h"
 #include "i18n_korean.h"
 
+static coord last_delt= {0,0};		/* Last delta from get_dir() */
+
+GAMEVAR misc_vars[] = {
+    GV(last_delt),
+    GV_END
+};
+
 /*
  * look:
  *	A quick glance all around the player
@@ -117,13 +124,11 @@ look(bool wakeup)
 	    if (on(player, ISBLIND) && (y != hero.y || x != hero.x))
 		continue;
 
-	    move(y, x);
-
 	    if ((proom->r_flags & ISDARK) && !see_floor && ch == FLOOR)
 		ch = ' ';
 
-	    if (tp != NULL || ch != CCHAR( inch() ))
-		addch(ch);
+	    if (tp != NULL || ch != CCHAR( shown(y, x) ))
+		mvshow(y, x, ch);
 
 	    if (door_stop && !firstmove && running)
 	    {
@@ -178,7 +183,7 @@ look(bool wakeup)
     if (door_stop && !firstmove && passcount > 1)
 	running = FALSE;
     if (!running || !jump)
-	mvaddch(hero.y, hero.x, PLAYER);
+	mvshow(hero.y, hero.x, PLAYER);
 # ifdef DEBUG
     done = FALSE;
 # endif /* DEBUG */
@@ -192,6 +197,8 @@ look(bool wakeup)
 int
 trip_ch(int y, int x, int ch)
 {
+    int ors;
+
     if (on(player, ISHALU) && after)
 	switch (ch)
 	{
@@ -205,7 +212,11 @@ trip_ch(int y, int x, int ch)
 		break;
 	    default:
 		if (y != stairs.y || x != stairs.x || !seenstairs)
+		{
+		    ors = rng_use(RS_LOOK);
 		    ch = rnd_thing();
+		    rng_use(ors);
+		}
 		break;
 	}
     return ch;
@@ -233,9 +244,8 @@ erase_lamp(coord *pos, struct room *rp)
 	{
 	    if (y == hero.y && x == hero.x)
 		continue;
-	    move(y, x);
-	    if (inch() == FLOOR)
-		addch(' ');
+	    if (shown(y, x) == FLOOR)
+		mvshow(y, x, ' ');
 	}
 }
 
@@ -261,11 +271,8 @@ find_obj(int y, int x)
 {
     THING *obj;
 
-    for (obj = lvl_obj; obj != NULL; obj = next(obj))
-    {
-	if (obj->o_pos.y == y && obj->o_pos.x == x)
-		return obj;
-    }
+    if ((obj = obat(y, x)) != NULL)
+	return obj;
 #ifdef MASTER
     msg(msg_get("MSG_DEBUG_NON_OBJECT"), y, x);
     return NULL;
@@ -469,7 +476,6 @@ get_dir()
 {
     const char *prompt;
     bool gotit;
-    static coord last_delt= {0,0};
 
     if (again && last_dir != '\0')
     {
@@ -486,7 +492,11 @@ get_dir()
 	do
 	{
 	    gotit = TRUE;
-	    switch (dir_ch = readchar())
+	    if (action != NULL)
+		dir_ch = act_key(&action->a_dir);
+	    else
+		dir_ch = readchar();
+	    switch (dir_ch)
 	    {
 		case 'h': case'H': delta.y =  0; delta.x = -1;
 		when 'j': case'J': delta.y =  1; delta.x =  0;
@@ -546,6 +556,7 @@ call_it(struct obj_info *info)
 		free(info->oi_guess);
 	    info->oi_guess = malloc((unsigned int) strlen(prbuf) + 1);
 	    strcpy(info->oi_guess, prbuf);
+	    forget_names();
 	}
     }
 }
@@ -66,12 +66,13 @@ new_monster(THING *tp, char type, coord *cp)
     if ((lev_add = level - AMULETLEVEL) < 0)
 	lev_add = 0;
     attach(mlist, tp);
+    tp->t_seq = ++mon_seq;
     tp->t_type = type;
     tp->t_disguise = type;
     tp->t_pos = *cp;
-    move(cp->y, cp->x);
-    tp->t_oldch = CCHAR( inch() );
+    tp->t_oldch = CCHAR( shown(cp->y, cp->x) );
     tp->t_room = roomin(cp);
+    room_attach(tp);
     moat(cp->y, cp->x) = tp;
     mp = &monsters[tp->t_type-'A'];
     tp->t_stats.s_lvl = mp->m_stats.s_lvl + lev_add;
@@ -122,20 +123,19 @@ wanderer()
     THING *tp;
     static coord cp;
 
-    tp = new_item();
     do
     {
-	find_floor((struct room *) NULL, &cp, FALSE, TRUE);
+	if (!find_floor((struct room *) NULL, &cp, FALSE, TRUE))
+	    return;			/* No room for one */
     } while (roomin(&cp) == proom);
+    tp = new_item();
     new_monster(tp, randmonster(TRUE), &cp);
     if (on(player, SEEMONST))
     {
-	standout();
 	if (!on(player, ISHALU))
-	    addch(tp->t_type);
+	    mvshow(cp.y, cp.x, tp->t_type | A_STANDOUT);
 	else
-	    addch(rnd(26) + 'A');
-	standend();
+	    mvshow(cp.y, cp.x, (rnd(26) + 'A') | A_STANDOUT);
     }
     runto(&tp->t_pos);
 #ifdef MASTER
@@ -171,7 +171,7 @@ wake_monster(int y, int x)
     if (!on(*tp, ISRUN) && rnd(3) != 0 && on(*tp, ISMEAN) && !on(*tp, ISHELD)
 	&& !ISWEARING(R_STEALTH) && !on(player, ISLEVIT))
     {
-	tp->t_dest = &hero;
+	set_dest(tp, &hero);
 	tp->t_flags |= ISRUN;
     }
     if (ch == 'M' && !on(player, ISBLIND) && !on(player, ISHALU)
@@ -204,9 +204,9 @@ wake_monster(int y, int x)
     {
 	tp->t_flags |= ISRUN;
 	if (proom->r_goldval)
-	    tp->t_dest = &proom->r_gold;
+	    set_dest(tp, &proom->r_gold);
 	else
-	    tp->t_dest = &hero;
+	    set_dest(tp, &hero);
     }
     return tp;
 }
@@ -193,7 +193,7 @@ hit_bound:
 		if (ch != STAIRS)
 		    take = ch;
 move_stuff:
-		mvaddch(hero.y, hero.x, floor_at());
+		mvshow(hero.y, hero.x, floor_at());
 		if ((fl & F_PASS) && chat(oldpos.y, oldpos.x) == DOOR)
 		    leave_room(&nh);
 		hero = nh;
@@ -231,7 +231,7 @@ turnref()
 	if (jump)
 	{
 	    leaveok(stdscr, TRUE);
-	    refresh();
+	    show_frame();
 	    leaveok(stdscr, FALSE);
 	}
 	pp->p_flags |= F_SEEN;
@@ -330,7 +330,7 @@ be_trapped(coord *tc)
 	     * down for us, so we have to do it ourself
 	     */
 	    teleport();
-	    mvaddch(tc->y, tc->x, TRAP);
+	    mvshow(tc->y, tc->x, TRAP);
 	when T_DART:
 	    if (!swing(pstats.s_lvl+1, pstats.s_arm, 1))
 		msg(msg_get("MSG_MOVE_DART_WHIZZES"));
@@ -364,10 +364,13 @@ rndmove(THING *who)
     THING *obj;
     int x, y;
     char ch;
+    int ors;
     static coord ret;  /* what we will be returning */
 
+    ors = rng_use(RS_MONST);
     y = ret.y = who->t_pos.y + rnd(3) - 1;
     x = ret.x = who->t_pos.x + rnd(3) - 1;
+    rng_use(ors);
     /*
      * Now check to see if that's a legal move.  If not, don't move.
      * (I.e., bump into the wall or whatever)
@@ -383,9 +386,7 @@ rndmove(THING *who)
 	    goto bad;
 	if (ch == SCROLL)
 	{
-	    for (obj = lvl_obj; obj != NULL; obj = next(obj))
-		if (y == obj->o_pos.y && x == obj->o_pos.x)
-		    break;
+	    obj = obat(y, x);
 	    if (obj != NULL && obj->o_which == S_SCARE)
 		goto bad;
 	}
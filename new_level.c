@@ -18,38 +18,118 @@
 #define TREAS_ROOM 20	/* one chance in TREAS_ROOM for a treasure room */
 #define MAXTREAS 10	/* maximum number of treasures in a treasure room */
 #define MINTREAS 2	/* minimum number of treasures in a treasure room */
+#define MAXTRIES 10	/* max number of tries to put down a monster */
 
 void
 new_level()
 {
     THING *tp;
-    PLACE *pp;
-    char *sp;
-    int i;
+    int ors;
 
+    rng_level(level);
+    ors = rng_use(RS_LEVEL);
     player.t_flags &= ~ISHELD;	/* unhold when you go down just in case */
     if (level > max_level)
 	max_level = level;
+    clear_level();
+    clear();
+    wipe_status();
+    if (!load_level())
+    {
+	dig_level();
+	keep_level();
+    }
+    seenstairs = FALSE;
+
     /*
-     * Clean things off from last level
+     * If there is nowhere to put the hero, dig another level.
+     * This one is not kept, since it can only be put back as full.
      */
+    for (;;)
+    {
+	for (tp = mlist; tp != NULL; tp = next(tp))
+	{
+	    room_detach(tp);
+	    tp->t_room = roomin(&tp->t_pos);
+	    room_attach(tp);
+	}
+	if (find_floor((struct room *) NULL, &hero, FALSE, TRUE))
+	    break;
+	clear_level();
+	dig_level();
+    }
+    enter_room(&hero);
+    mvshow(hero.y, hero.x, PLAYER);
+    rng_use(ors);
+    if (on(player, SEEMONST))
+	turn_see(FALSE);
+    if (on(player, ISHALU))
+	visuals();
+}
+
+/*
+ * clear_level:
+ *	Clean things off from the last level
+ */
+
+void
+clear_level()
+{
+    THING *tp;
+    PLACE *pp;
+
     for (pp = places; pp < &places[MAXCOLS*MAXLINES]; pp++)
     {
 	pp->p_ch = ' ';
 	pp->p_flags = F_REAL;
+	pp->p_pnum = 0;
 	pp->p_monst = NULL;
+	pp->p_obj = NULL;
+	pp->p_show = pp->p_drawn = ' ';
     }
-    clear();
     /*
      * Free up the monsters on the last level
      */
     for (tp = mlist; tp != NULL; tp = next(tp))
 	free_list(tp->t_pack);
     free_list(mlist);
+    index_rooms();
     /*
      * Throw away stuff left on the previous level (if anything)
      */
     free_list(lvl_obj);
+}
+
+/*
+ * floor_left:
+ *	Is there any plain floor left on the level for a trap
+ */
+
+static bool
+floor_left()
+{
+    PLACE *pp;
+
+    for (pp = places; pp < &places[MAXCOLS*MAXLINES]; pp++)
+	if (pp->p_ch == FLOOR)
+	    return TRUE;
+    return FALSE;
+}
+
+/*
+ * dig_level:
+ *	Lay out the rooms, passages, things and traps of a new level
+ *	and pick where the stairs go.  If there is nowhere left for the
+ *	stairs, the level is thrown away and dug again.
+ */
+
+void
+dig_level()
+{
+    char *sp;
+    int i, tries;
+
+again:
     do_rooms();				/* Draw rooms */
     do_passages();			/* Draw passages */
     no_food++;
@@ -69,11 +149,18 @@ new_level()
 	     * not only wouldn't it be NICE to have traps in mazes
 	     * (not that we care about being nice), since the trap
 	     * number is stored where the passage number is, we
-	     * can't actually do it.
+	     * can't actually do it.  Every so often make sure there
+	     * is a floor spot left to find, or there are no more traps.
 	     */
+	    tries = 0;
 	    do
 	    {
-		find_floor((struct room *) NULL, &stairs, FALSE, FALSE);
+		if (!find_floor((struct room *) NULL, &stairs, FALSE, FALSE)
+		    || (++tries % MAXTRIES == 0 && !floor_left()))
+		{
+		    ntraps -= i + 1;
+		    goto stairway;
+		}
 	    } while (chat(stairs.y, stairs.x) != FLOOR);
 	    sp = &flat(stairs.y, stairs.x);
 	    *sp &= ~F_REAL;
@@ -83,20 +170,13 @@ new_level()
     /*
      * Place the staircase down.
      */
-    find_floor((struct room *) NULL, &stairs, FALSE, FALSE);
+stairway:
+    if (!find_floor((struct room *) NULL, &stairs, FALSE, FALSE))
+    {
+	clear_level();
+	goto again;
+    }
     chat(stairs.y, stairs.x) = STAIRS;
-    seenstairs = FALSE;
-
-    for (tp = mlist; tp != NULL; tp = next(tp))
-	tp->t_room = roomin(&tp->t_pos);
-
-    find_floor((struct room *) NULL, &hero, FALSE, TRUE);
-    enter_room(&hero);
-    mvaddch(hero.y, hero.x, PLAYER);
-    if (on(player, SEEMONST))
-	turn_see(FALSE);
-    if (on(player, ISHALU))
-	visuals();
 }
 
 /*
@@ -110,6 +190,7 @@ rnd_room()
 
     do
     {
+	room_tries++;
 	rm = rnd(MAXROOMS);
     } while (rooms[rm].r_flags & ISGONE);
     return rm;
@@ -147,11 +228,15 @@ put_things()
 	     * Pick a new object and link it in the list
 	     */
 	    obj = new_thing();
-	    attach(lvl_obj, obj);
 	    /*
-	     * Put it somewhere
+	     * Put it somewhere, if there is anywhere left
 	     */
-	    find_floor((struct room *) NULL, &obj->o_pos, FALSE, FALSE);
+	    if (!find_floor((struct room *) NULL, &obj->o_pos, FALSE, FALSE))
+	    {
+		discard(obj);
+		continue;
+	    }
+	    attach_obj(obj);
 	    chat(obj->o_pos.y, obj->o_pos.x) = (char) obj->o_type;
 	}
     /*
@@ -161,7 +246,6 @@ put_things()
     if (level >= AMULETLEVEL && !amulet)
     {
 	obj = new_item();
-	attach(lvl_obj, obj);
 	obj->o_hplus = 0;
 	obj->o_dplus = 0;
 	strncpy(obj->o_damage,"0x0",sizeof(obj->o_damage));
@@ -169,9 +253,14 @@ put_things()
 	obj->o_arm = 11;
 	obj->o_type = AMULET;
 	/*
-	 * Put it somewhere
+	 * Put it somewhere, or it waits for the next level
 	 */
-	find_floor((struct room *) NULL, &obj->o_pos, FALSE, FALSE);
+	if (!find_floor((struct room *) NULL, &obj->o_pos, FALSE, FALSE))
+	{
+	    discard(obj);
+	    return;
+	}
+	attach_obj(obj);
 	chat(obj->o_pos.y, obj->o_pos.x) = AMULET;
     }
 }
@@ -180,7 +269,6 @@ put_things()
  * treas_room:
  *	Add a treasure room
  */
-#define MAXTRIES 10	/* max number of tries to put down a monster */
 
 
 void
@@ -202,7 +290,7 @@ treas_room()
 	find_floor(rp, &mp, 2 * MAXTRIES, FALSE);
 	tp = new_thing();
 	tp->o_pos = mp;
-	attach(lvl_obj, tp);
+	attach_obj(tp);
 	chat(mp.y, mp.x) = (char) tp->o_type;
     }
 
@@ -0,0 +1,221 @@
+/*
+ * For programs that play rogue and would rather not read the screen
+ * or type: write what the hero can see each time the game waits for a
+ * command, and take commands as actions, with everything they ask for
+ * filled in.  observe.h has the layouts.
+ *
+ * Rogue: Exploring the Dungeons of Doom
+ * Copyright (C) 1980-1983, 1985, 1999 Michael Toy, Ken Arnold and Glenn Wichman
+ * All rights reserved.
+ *
+ * See the file LICENSE.TXT for full copyright and licensing information.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+#include <curses.h>
+#include "rogue.h"
+
+static FILE *obs_fp = NULL;		/* Where observations are going */
+static char obs_name[MAXSTR];		/* And what it was called */
+static uint32_t obs_seq = 0;
+static int obs_msgs = 0;		/* Messages already written out */
+static FILE *act_fp = NULL;		/* Where actions are coming from */
+static char act_name[MAXSTR];		/* And what it was called */
+static ACTION *queued = NULL;		/* Given to do_action() */
+static ACTION cur_act;			/* The one being carried out */
+
+/*
+ * reopen:
+ *	Open a file named by an option, if it has changed since it was
+ *	last opened
+ */
+
+static FILE *
+reopen(FILE *fp, char *was, char *name, const char *mode)
+{
+    if (strcmp(was, name) == 0)
+	return fp;
+    if (fp != NULL)
+	fclose(fp);
+    strcpy(was, name);
+    if (name[0] == '\0')
+	return NULL;
+    return fopen(name, mode);
+}
+
+/*
+ * observe:
+ *	Write an observation to obs_file, if there is one, opening it
+ *	the first time or when the option has been changed
+ */
+
+void
+observe()
+{
+    obs_fp = reopen(obs_fp, obs_name, obs_file, "wb");
+    if (obs_fp == NULL)
+	return;
+    write_obs(obs_fp);
+    fflush(obs_fp);
+}
+
+/*
+ * write_obs:
+ *	Write one observation of how things stand now
+ */
+
+void
+write_obs(FILE *fp)
+{
+    static char map[NUMLINES * NUMCOLS];
+    static OBMONST mons[NUMLINES * NUMCOLS];	/* one to a spot at most */
+    static OBITEM items[MAXPACK + 1];
+    static OBLOG logs[MSGLOG];
+    OBHEAD head;
+    THING *tp;
+    char ch, *sp;
+    int y, x, nm, ni, nl;
+    long turn;
+
+    /*
+     * The map is what should be on the screen, so it already leaves
+     * out whatever he has not seen or cannot see now
+     */
+    memset(map, ' ', sizeof map);
+    nm = 0;
+    for (y = 1; y < NUMLINES - 1; y++)
+	for (x = 0; x < NUMCOLS; x++)
+	    map[y * NUMCOLS + x] = CCHAR(shown(y, x));
+    for (tp = mlist; tp != NULL; tp = next(tp))
+    {
+	ch = CCHAR(shown(tp->t_pos.y, tp->t_pos.x));
+	if (!isupper(ch))
+	    continue;
+	mons[nm].om_y = (int16_t) tp->t_pos.y;
+	mons[nm].om_x = (int16_t) tp->t_pos.x;
+	mons[nm].om_ch = ch;
+	mons[nm].om_pad = 0;
+	nm++;
+    }
+    ni = 0;
+    for (tp = pack; tp != NULL && ni <= MAXPACK; tp = next(tp))
+    {
+	items[ni].oi_ch = tp->o_packch;
+	items[ni].oi_type = (char) tp->o_type;
+	items[ni].oi_count = (int16_t) tp->o_count;
+	sp = inv_name(tp, FALSE);
+	strncpy(items[ni].oi_name, sp, OB_NAMELEN - 1);
+	items[ni].oi_name[OB_NAMELEN - 1] = '\0';
+	ni++;
+    }
+    nl = 0;
+    if (obs_msgs > msg_count())		/* a game was restored since */
+	obs_msgs = msg_count();
+    while (obs_msgs < msg_count())
+    {
+	if ((sp = old_msg(msg_count() - 1 - obs_msgs++, &turn)) == NULL)
+	    continue;			/* forgotten before it could be sent */
+	memset(&logs[nl], 0, sizeof logs[nl]);
+	logs[nl].ol_turn = (int32_t) turn;
+	strncpy(logs[nl].ol_text, sp, OB_LOGLEN - 1);
+	nl++;
+    }
+
+    memset(&head, 0, sizeof head);
+    head.ob_magic = OB_MAGIC;
+    head.ob_size = (uint32_t) (sizeof head + sizeof map
+	+ nm * sizeof mons[0] + ni * sizeof items[0] + nl * sizeof logs[0]);
+    head.ob_seq = ++obs_seq;
+    head.ob_lines = NUMLINES;
+    head.ob_cols = NUMCOLS;
+    head.ob_nmonst = nm;
+    head.ob_npack = ni;
+    head.ob_level = level;
+    head.ob_y = hero.y;
+    head.ob_x = hero.x;
+    head.ob_str = pstats.s_str;
+    head.ob_maxstr = max_stats.s_str;
+    head.ob_hp = pstats.s_hpt;
+    head.ob_maxhp = max_hp;
+    head.ob_arm = 10 - (cur_armor != NULL ? cur_armor->o_arm : pstats.s_arm);
+    head.ob_lvl = pstats.s_lvl;
+    head.ob_exp = pstats.s_exp;
+    head.ob_purse = purse;
+    head.ob_hunger = hungry_state;
+    strncpy(head.ob_msg, huh, OB_MSGLEN - 1);
+
+    fwrite(&head, sizeof head, 1, fp);
+    fwrite(map, sizeof map, 1, fp);
+    fwrite(mons, sizeof mons[0], nm, fp);
+    fwrite(items, sizeof items[0], ni, fp);
+    fwrite(logs, sizeof logs[0], nl, fp);
+}
+
+/*
+ * next_cmd:
+ *	Get the next command: an action given to do_action(), the next
+ *	one in act_file, or else one typed at the keyboard
+ */
+
+char
+next_cmd()
+{
+    action = NULL;
+    act_fp = reopen(act_fp, act_name, act_file, "rb");
+    if (queued != NULL)
+    {
+	cur_act = *queued;
+	queued = NULL;
+	action = &cur_act;
+    }
+    else if (act_fp != NULL)
+    {
+	if (fread(&cur_act, sizeof cur_act, 1, act_fp) == 1)
+	    action = &cur_act;
+	else
+	{
+	    /*
+	     * Nothing more is coming, so go back to the keyboard
+	     */
+	    fclose(act_fp);
+	    act_fp = NULL;
+	}
+    }
+    if (action == NULL)
+	return readchar();
+    return action->a_cmd;
+}
+
+/*
+ * act_key:
+ *	The answer the action has for a question, which it only gives
+ *	once; after that, or if it has none, readchar() gives ESCAPE
+ */
+
+char
+act_key(char *cp)
+{
+    char ch;
+
+    if ((ch = *cp) == '\0')
+	return readchar();
+    *cp = '\0';
+    return ch;
+}
+
+/*
+ * do_action:
+ *	Carry out an action, and keep going until it is all done: until
+ *	a run stops, a count runs out or a fight to the death is over
+ */
+
+void
+do_action(ACTION *ap)
+{
+    queued = ap;
+    do
+	command();
+    while (queued != NULL || running || count || to_death);
+}
@@ -0,0 +1,85 @@
+/*
+ * Layout of what passes between rogue and programs that play it:
+ * observations going out and actions coming in
+ *
+ * Each time the game waits for a command it writes one record: an
+ * OBHEAD, then ob_lines * ob_cols bytes of map (row by row, one byte
+ * per spot, just what is on the screen), then ob_nmonst OBMONSTs, then
+ * ob_npack OBITEMs, then an OBLOG for each message shown since the
+ * last record, oldest first, as many as the rest of ob_size holds.
+ * Everything is in the byte order of the machine the game runs on.
+ * ob_size is the length of the whole record, so a reader can skip what
+ * it does not know about.
+ *
+ * Actions are read as ACTION records, one for each command.  This file
+ * only uses <stdint.h>, so a player program can include it without the
+ * rest of rogue.
+ *
+ * Rogue: Exploring the Dungeons of Doom
+ * Copyright (C) 1980-1983, 1985, 1999 Michael Toy, Ken Arnold and Glenn Wichman
+ * All rights reserved.
+ *
+ * See the file LICENSE.TXT for full copyright and licensing information.
+ */
+
+#ifndef OBSERVE_H
+#define OBSERVE_H
+
+#include <stdint.h>
+
+#define OB_MAGIC	0x524f4231	/* "ROB1" */
+#define OB_MSGLEN	80		/* Bytes of message line kept */
+#define OB_NAMELEN	60		/* Bytes of item name kept */
+#define OB_LOGLEN	160		/* Bytes of logged message kept */
+
+typedef struct {
+    uint32_t ob_magic;			/* OB_MAGIC */
+    uint32_t ob_size;			/* Bytes in the whole record */
+    uint32_t ob_seq;			/* One more than the last record */
+    int32_t ob_lines, ob_cols;		/* Size of the map */
+    int32_t ob_nmonst, ob_npack;	/* Monsters and items that follow */
+    int32_t ob_level;			/* Depth of the dungeon */
+    int32_t ob_y, ob_x;			/* Where the hero is */
+    int32_t ob_str, ob_maxstr;		/* Strength */
+    int32_t ob_hp, ob_maxhp;		/* Hit points */
+    int32_t ob_arm;			/* Armor class as shown */
+    int32_t ob_lvl, ob_exp;		/* Experience level and points */
+    int32_t ob_purse;			/* Gold */
+    int32_t ob_hunger;			/* 0 fed, 1 hungry, 2 weak, 3 faint */
+    char ob_msg[OB_MSGLEN];		/* Last message, '\0' ended */
+} OBHEAD;
+
+typedef struct {
+    int16_t om_y, om_x;			/* Where it is */
+    char om_ch;				/* What it looks like */
+    char om_pad;
+} OBMONST;
+
+typedef struct {
+    char oi_ch;				/* Its letter in the pack */
+    char oi_type;			/* What kind of thing it is */
+    int16_t oi_count;			/* How many */
+    char oi_name[OB_NAMELEN];		/* As the inventory has it */
+} OBITEM;
+
+typedef struct {
+    int32_t ol_turn;			/* Turn it was shown on */
+    char ol_text[OB_LOGLEN];		/* What it said, '\0' ended */
+} OBLOG;
+
+/*
+ * A command with whatever it would ask for already filled in.  Any
+ * other question it asks is answered with ESCAPE, and a --More-- is
+ * not waited on, so the keyboard is never read while it is carried
+ * out.
+ */
+typedef struct {
+    char a_cmd;				/* Command, as it would be typed */
+    char a_dir;				/* Direction: h, j, k, l, y, u, b or n */
+    char a_item;			/* Pack letter of what to use */
+    char a_other;			/* Pack letter of what it is used on */
+    char a_hand;			/* l or r, for rings */
+    uint8_t a_count;			/* Times to repeat it, or 0 */
+} ACTION;
+
+#endif /* OBSERVE_H */
@@ -60,7 +60,31 @@ OPTION	optlist[] = {
     {"fruit",	 NULL,
 		 fruit,		put_str,	get_str		},
     {"file",	 NULL,
-		 file_name,	put_str,	get_str		}
+		 file_name,	put_str,	get_str		},
+    {"animate",	 NULL,
+		 &animate,	put_bool,	get_bool	},
+    {"framerate", NULL,
+		 &frame_rate,	put_num,	get_num		},
+    {"fastrng",	 NULL,
+		 &fast_rng,	put_bool,	get_bool	},
+    {"levelcache", NULL,
+		 &level_cache,	put_bool,	get_bool	},
+    {"cachedir", NULL,
+		 cache_dir,	put_str,	get_str		},
+    {"digahead", NULL,
+		 &pre_dig,	put_bool,	get_bool	},
+    {"observe",	 NULL,
+		 obs_file,	put_str,	get_str		},
+    {"actions",	 NULL,
+		 act_file,	put_str,	get_str		},
+    {"record",	 NULL,
+		 rec_file,	put_str,	get_str		},
+    {"ttyrec",	 NULL,
+		 tty_file,	put_str,	get_str		},
+    {"watch",	 NULL,
+		 watch_file,	put_str,	get_str		},
+    {"more",	 NULL,
+		 &more_msg,	put_bool,	get_bool	}
 };
 
 /*
@@ -80,6 +104,18 @@ init_options()
     optlist[7].o_prompt = (char *)msg_get("MSG_OPT_NAME");
     optlist[8].o_prompt = (char *)msg_get("MSG_OPT_FRUIT");
     optlist[9].o_prompt = (char *)msg_get("MSG_OPT_FILE");
+    optlist[10].o_prompt = (char *)msg_get("MSG_OPT_ANIMATE");
+    optlist[11].o_prompt = (char *)msg_get("MSG_OPT_FRAMERATE");
+    optlist[12].o_prompt = (char *)msg_get("MSG_OPT_FASTRNG");
+    optlist[13].o_prompt = (char *)msg_get("MSG_OPT_LEVELCACHE");
+    optlist[14].o_prompt = (char *)msg_get("MSG_OPT_CACHEDIR");
+    optlist[15].o_prompt = (char *)msg_get("MSG_OPT_DIGAHEAD");
+    optlist[16].o_prompt = (char *)msg_get("MSG_OPT_OBSERVE");
+    optlist[17].o_prompt = (char *)msg_get("MSG_OPT_ACTIONS");
+    optlist[18].o_prompt = (char *)msg_get("MSG_OPT_RECORD");
+    optlist[19].o_prompt = (char *)msg_get("MSG_OPT_TTYREC");
+    optlist[20].o_prompt = (char *)msg_get("MSG_OPT_WATCH");
+    optlist[21].o_prompt = (char *)msg_get("MSG_OPT_MORE");
 }
 
 /*
@@ -127,6 +163,9 @@ option()
 	    }
 	}
     }
+    if (serving)
+	no_files();
+    forget_names();		/* the fruit may have a new name */
     /*
      * Switch back to original screen
      */
@@ -139,6 +178,23 @@ option()
     after = FALSE;
 }
 
+/*
+ * no_files:
+ *	Forget the files options name, for a game on a server, whose
+ *	player has no business reading or writing files there
+ */
+
+void
+no_files()
+{
+    cache_dir[0] = '\0';
+    obs_file[0] = '\0';
+    act_file[0] = '\0';
+    rec_file[0] = '\0';
+    tty_file[0] = '\0';
+    watch_file[0] = '\0';
+}
+
 /*
  * pr_optname:
  *	Print out the option name prompt
@@ -172,6 +228,17 @@ put_str(void *str)
     waddstr(hw, (char *) str);
 }
 
+/*
+ * put_num:
+ *	Put out a number
+ */
+
+void
+put_num(void *ip)
+{
+    wprintw(hw, "%d", *(int *) ip);
+}
+
 /*
  * put_inv_t:
  *	Put out an inventory type
@@ -390,7 +457,6 @@ get_inv_t(void *vp, WINDOW *win)
 }
 	
 
-#ifdef MASTER
 /*
  * get_num:
  *	Get a numeric option
@@ -398,15 +464,15 @@ get_inv_t(void *vp, WINDOW *win)
 int
 get_num(void *vp, WINDOW *win)
 {
-    short *opt = (short *) vp;
+    int *opt = (int *) vp;
     int i;
     static char buf[MAXSTR];
 
-    if ((i = get_str(buf, win)) == NORM)
-	*opt = (short) atoi(buf);
+    sprintf(buf, "%d", *opt);
+    if ((i = get_str(buf, win)) == NORM && (*opt = atoi(buf)) < 0)
+	*opt = 0;
     return i;
 }
-#endif
 
 /*
  * parse_opts:
@@ -477,6 +543,11 @@ parse_opts(char *str)
 				break;
 			    }
 		    }
+		    else if (op->o_putfunc == put_num)
+		    {
+			if ((*(int *)op->o_opt = atoi(str)) < 0) /* NOSTRICT */
+			    *(int *)op->o_opt = 0;
+		    }
 		    else
 			strucpy(start, str, (int)(sp - str));
 		}
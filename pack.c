@@ -43,8 +43,9 @@ add_pack(THING *obj, bool silent)
     if (obj->o_type == SCROLL && obj->o_which == S_SCARE)
 	if (obj->o_flags & ISFOUND)
 	{
-	    detach(lvl_obj, obj);
-	    mvaddch(hero.y, hero.x, floor_ch());
+	    unclaim(obj);
+	    detach_obj(obj);
+	    mvshow(hero.y, hero.x, floor_ch());
 	    chat(hero.y, hero.x) = (proom->r_flags & ISGONE) ? PASSAGE : FLOOR;
 	    discard(obj);
 	    msg(msg_get("MSG_SCROLL_TO_DUST"));
@@ -141,9 +142,7 @@ out:
      * If this was the object of something's desire, that monster will
      * get mad and run at the hero.
      */
-    for (op = mlist; op != NULL; op = next(op))
-	if (op->t_dest == &obj->o_pos)
-	    op->t_dest = &hero;
+    unclaim(obj);
 
     if (obj->o_type == AMULET)
 	amulet = TRUE;
@@ -183,8 +182,8 @@ pack_room(bool from_floor, THING *obj)
 
     if (from_floor)
     {
-	detach(lvl_obj, obj);
-	mvaddch(hero.y, hero.x, floor_ch());
+	detach_obj(obj);
+	mvshow(hero.y, hero.x, floor_ch());
 	chat(hero.y, hero.x) = (proom->r_flags & ISGONE) ? PASSAGE : FLOOR;
     }
 
@@ -249,7 +248,7 @@ pack_char()
 bool
 inventory(THING *list, int type)
 {
-    static char inv_temp[MAXSTR];
+    static char inv_line[MAXSTR];
 
     n_objs = 0;
     for (; list != NULL; list = next(list))
@@ -259,14 +258,13 @@ inventory(THING *list, int type)
 	    !(type == R_OR_S && (list->o_type == RING || list->o_type == STICK)))
 		continue;
 	n_objs++;
-#ifdef MASTER
-	if (!list->o_packch)
-	    strcpy(inv_temp, "%s");
+	if (list->o_packch)
+	    snprintf(inv_line, sizeof inv_line, "%c) %s", list->o_packch,
+		inv_name(list, FALSE));
 	else
-#endif
-	    sprintf(inv_temp, "%c) %%s", list->o_packch);
+	    snprintf(inv_line, sizeof inv_line, "%s", inv_name(list, FALSE));
 	msg_esc = TRUE;
-	if (add_line(inv_temp, inv_name(list, FALSE)) == ESCAPE)
+	if (add_text(inv_line) == ESCAPE)
 	{
 	    msg_esc = FALSE;
 	    msg("");
@@ -311,7 +309,7 @@ pick_up(char ch)
 		if (obj == NULL)
 		    return;
 		money(obj->o_goldval);
-		detach(lvl_obj, obj);
+		detach_obj(obj);
 		discard(obj);
 		proom->r_goldval = 0;
 		break;
@@ -406,7 +404,12 @@ get_item(const char *purpose, int type)
 	    if (terse)
 		addmsg(msg_get("MSG_WHAT"));
 	    msg(msg_get("MSG_FOR_LIST"));
-	    ch = readchar();
+	    if (action == NULL)
+		ch = readchar();
+	    else if (action->a_item != '\0')
+		ch = act_key(&action->a_item);
+	    else
+		ch = act_key(&action->a_other);
 	    mpos = 0;
 	    /*
 	     * Give the poor player a chance to abort the command
@@ -435,6 +438,12 @@ get_item(const char *purpose, int type)
 	    if (obj == NULL)
 	    {
 		msg(msg_get("MSG_NOT_VALID_ITEM"), unctrl(ch));
+		if (action != NULL)
+		{
+		    reset_last();
+		    after = FALSE;
+		    return NULL;
+		}
 		continue;
 	    }
 	    else 
@@ -453,7 +462,7 @@ void
 money(int value)
 {
     purse += value;
-    mvaddch(hero.y, hero.x, floor_ch());
+    mvshow(hero.y, hero.x, floor_ch());
     chat(hero.y, hero.x) = (proom->r_flags & ISGONE) ? PASSAGE : FLOOR;
     if (value > 0)
     {
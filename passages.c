@@ -31,25 +31,22 @@ do_passages()
 	bool	conn[MAXROOMS];		/* possible to connect to room i? */
 	bool	isconn[MAXROOMS];	/* connection been made to room i? */
 	bool	ingraph;		/* this room in graph already? */
-    } rdes[MAXROOMS] = {
-	{ { 0, 1, 0, 1, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0, 0, 0, 0 }, 0 },
-	{ { 1, 0, 1, 0, 1, 0, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0, 0, 0, 0 }, 0 },
-	{ { 0, 1, 0, 0, 0, 1, 0, 0, 0 }, { 0, 0, 0, 0, 0, 0, 0, 0, 0 }, 0 },
-	{ { 1, 0, 0, 0, 1, 0, 1, 0, 0 }, { 0, 0, 0, 0, 0, 0, 0, 0, 0 }, 0 },
-	{ { 0, 1, 0, 1, 0, 1, 0, 1, 0 }, { 0, 0, 0, 0, 0, 0, 0, 0, 0 }, 0 },
-	{ { 0, 0, 1, 0, 1, 0, 0, 0, 1 }, { 0, 0, 0, 0, 0, 0, 0, 0, 0 }, 0 },
-	{ { 0, 0, 0, 1, 0, 0, 0, 1, 0 }, { 0, 0, 0, 0, 0, 0, 0, 0, 0 }, 0 },
-	{ { 0, 0, 0, 0, 1, 0, 1, 0, 1 }, { 0, 0, 0, 0, 0, 0, 0, 0, 0 }, 0 },
-	{ { 0, 0, 0, 0, 0, 1, 0, 1, 0 }, { 0, 0, 0, 0, 0, 0, 0, 0, 0 }, 0 },
-    };
+    } rdes[MAXROOMS];
 
     /*
-     * reinitialize room graph description
+     * reinitialize room graph description; each room can be joined
+     * to the ones beside it and above and below it on the grid
      */
-    for (r1 = rdes; r1 <= &rdes[MAXROOMS-1]; r1++)
+    for (r1 = rdes, i = 0; r1 <= &rdes[MAXROOMS-1]; r1++, i++)
     {
 	for (j = 0; j < MAXROOMS; j++)
+	{
+	    if (j / ROOMSX == i / ROOMSX)
+		r1->conn[j] = (j == i - 1 || j == i + 1);
+	    else
+		r1->conn[j] = (j == i - ROOMSX || j == i + ROOMSX);
 	    r1->isconn[j] = FALSE;
+	}
 	r1->ingraph = FALSE;
     }
 
@@ -125,6 +122,28 @@ do_passages()
     passnum();
 }
 
+/*
+ * maze_edge:
+ *	The bottom edge of a maze only has passage where the maze goes
+ *	down to its last row, and that can all be in the corners, where
+ *	conn() never puts a door.  Say whether there is a spot away from
+ *	the corners; if not, leave cp on a corner one.
+ */
+
+static bool
+maze_edge(struct room *rp, coord *cp)
+{
+    int x;
+
+    for (x = rp->r_pos.x + 1; x < rp->r_pos.x + rp->r_max.x - 1; x++)
+	if (flat(cp->y, x) & F_PASS)
+	    return TRUE;
+    cp->x = rp->r_pos.x + rp->r_max.x - 1;
+    if (!(flat(cp->y, cp->x) & F_PASS))
+	cp->x = rp->r_pos.x;
+    return FALSE;
+}
+
 /*
  * conn:
  *	Draw a corridor from a room in a certain direction.
@@ -163,7 +182,7 @@ conn(int r1, int r2)
      */
     if (direc == 'd')
     {
-	rmt = rm + 3;				/* room # of dest */
+	rmt = rm + ROOMSX;			/* room # of dest */
 	rpt = &rooms[rmt];			/* room pointer of dest */
 	del.x = 0;				/* direction of move */
 	del.y = 1;
@@ -172,11 +191,14 @@ conn(int r1, int r2)
 	epos.x = rpt->r_pos.x;			/* end of move */
 	epos.y = rpt->r_pos.y;
 	if (!(rpf->r_flags & ISGONE))		/* if not gone pick door pos */
-	    do
-	    {
-		spos.x = rpf->r_pos.x + rnd(rpf->r_max.x - 2) + 1;
-		spos.y = rpf->r_pos.y + rpf->r_max.y - 1;
-	    } while ((rpf->r_flags&ISMAZE) && !(flat(spos.y, spos.x)&F_PASS));
+	{
+	    spos.y = rpf->r_pos.y + rpf->r_max.y - 1;
+	    if (!(rpf->r_flags & ISMAZE) || maze_edge(rpf, &spos))
+		do
+		{
+		    spos.x = rpf->r_pos.x + rnd(rpf->r_max.x - 2) + 1;
+		} while ((rpf->r_flags&ISMAZE) && !(flat(spos.y, spos.x)&F_PASS));
+	}
 	if (!(rpt->r_flags & ISGONE))
 	    do
 	    {
@@ -337,17 +359,13 @@ add_pass()
 		if (pp->p_flags & F_PASS)
 		    ch = PASSAGE;
 		pp->p_flags |= F_SEEN;
-		move(y, x);
 		if (pp->p_monst != NULL)
 		    pp->p_monst->t_oldch = pp->p_ch;
 		else if (pp->p_flags & F_REAL)
-		    addch(ch);
+		    mvshow(y, x, ch);
 		else
-		{
-		    standout();
-		    addch((pp->p_flags & F_PASS) ? PASSAGE : DOOR);
-		    standend();
-		}
+		    mvshow(y, x, ((pp->p_flags & F_PASS) ? PASSAGE : DOOR)
+			| A_STANDOUT);
 	    }
 	}
 }
@@ -370,7 +388,10 @@ passnum()
     pnum = 0;
     newpnum = FALSE;
     for (rp = passages; rp < &passages[MAXPASS]; rp++)
+    {
+	rp->r_flags = ISGONE|ISDARK;
 	rp->r_nexits = 0;
+    }
     for (rp = rooms; rp < &rooms[MAXROOMS]; rp++)
 	for (i = 0; i < rp->r_nexits; i++)
 	{
@@ -394,7 +415,7 @@ numpass(int y, int x)
     if (x >= NUMCOLS || x < 0 || y >= NUMLINES || y <= 0)
 	return;
     fp = &flat(y, x);
-    if (*fp & F_PNUM)
+    if (pnat(y, x) != 0)
 	return;
     if (newpnum)
     {
@@ -414,7 +435,7 @@ numpass(int y, int x)
     }
     else if (!(*fp & F_PASS))
 	return;
-    *fp |= pnum;
+    pnat(y, x) = pnum;
     /*
      * recurse on the surrounding places
      */
@@ -283,7 +283,7 @@ invis_on()
     player.t_flags |= CANSEE;
     for (mp = mlist; mp != NULL; mp = next(mp))
 	if (on(*mp, ISINVIS) && see_monst(mp) && !on(player, ISHALU))
-	    mvaddch(mp->t_pos.y, mp->t_pos.x, mp->t_disguise);
+	    mvshow(mp->t_pos.y, mp->t_pos.x, mp->t_disguise);
 }
 
 /*
@@ -295,30 +295,29 @@ turn_see(bool turn_off)
 {
     THING *mp;
     bool can_see, add_new;
+    chtype ch;
 
     add_new = FALSE;
     for (mp = mlist; mp != NULL; mp = next(mp))
     {
-	move(mp->t_pos.y, mp->t_pos.x);
 	can_see = see_monst(mp);
 	if (turn_off)
 	{
 	    if (!can_see)
-		addch(mp->t_oldch);
+		mvshow(mp->t_pos.y, mp->t_pos.x, mp->t_oldch);
 	}
 	else
 	{
-	    if (!can_see)
-		standout();
 	    if (!on(player, ISHALU))
-		addch(mp->t_type);
+		ch = mp->t_type;
 	    else
-		addch(rnd(26) + 'A');
+		ch = rnd(26) + 'A';
 	    if (!can_see)
 	    {
-		standend();
+		ch |= A_STANDOUT;
 		add_new++;
 	    }
+	    mvshow(mp->t_pos.y, mp->t_pos.x, ch);
 	}
     }
     if (turn_off)
@@ -337,8 +336,7 @@ seen_stairs()
 {
     THING	*tp;
 
-    move(stairs.y, stairs.x);
-    if (inch() == STAIRS)			/* it's on the map */
+    if (shown(stairs.y, stairs.x) == STAIRS)			/* it's on the map */
 	return TRUE;
     if (ce(hero, stairs))			/* It's under him */
 	return TRUE;
@@ -0,0 +1,298 @@
+/*
+ * Recording games as the keys typed, and playing them back
+ *
+ * A recording is the seed and the options the game was started with,
+ * then each key readchar() handed back and the turn it was typed on,
+ * then how things stood when the game ended.  Since nothing else goes
+ * into a game, feeding the same keys back to the same seed plays the
+ * same game, which is checked against the end line.  Played back games
+ * are drawn on nothing and nobody waits for them.
+ *
+ * Rogue: Exploring the Dungeons of Doom
+ * Copyright (C) 1980-1983, 1985, 1999 Michael Toy, Ken Arnold and Glenn Wichman
+ * All rights reserved.
+ *
+ * See the file LICENSE.TXT for full copyright and licensing information.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <curses.h>
+#include "rogue.h"
+#include "i18n.h"
+
+#define REC_MAGIC	"rogue keys 1"
+
+#ifdef _WIN32
+#define NULL_DEVICE	"NUL"
+#else
+#define NULL_DEVICE	"/dev/null"
+#endif
+
+static FILE *rec_fp = NULL;		/* Where keys are going */
+static FILE *rep_fp = NULL;		/* Where keys are coming from */
+static char rep_opts[MAXSTR];		/* Options the game was played with */
+static int rep_flags[4];		/* terse, jump, see_floor, inv_type */
+static long nkeys = 0;			/* Keys played back so far */
+
+/*
+ * start_record:
+ *	Start writing keys to rec_file, if there is one.  Only new
+ *	games are recorded; a restored one starts from a save file, not
+ *	a seed.  Neither is one played with actions, which do not come
+ *	through readchar().
+ */
+
+void
+start_record()
+{
+    char *opts;
+
+    if (rec_file[0] == '\0' || restored || replaying || act_file[0] != '\0')
+	return;
+    if ((rec_fp = fopen(rec_file, "w")) == NULL)
+    {
+	msg(msg_get("MSG_RECORD_CANNOT_OPEN"), rec_file);
+	return;
+    }
+    if ((opts = getenv("ROGUEOPTS")) == NULL)
+	opts = "";
+    fprintf(rec_fp, "%s\n", REC_MAGIC);
+    fprintf(rec_fp, "version %s\n", release);
+    fprintf(rec_fp, "seed %d %s\n", dnum, fast_rng ? "fast" : "legacy");
+    fprintf(rec_fp, "name %s\n", whoami);
+    fprintf(rec_fp, "options %s\n", opts);
+    fprintf(rec_fp, "flags %d %d %d %d\n", terse, jump, see_floor, inv_type);
+}
+
+/*
+ * record_key:
+ *	Write down a key that was typed.  Keys come no faster than they
+ *	are typed, so each one goes straight out, and a game that is
+ *	killed is recorded up to where it stopped.
+ */
+
+void
+record_key(char ch)
+{
+    if (rec_fp == NULL)
+	return;
+    fprintf(rec_fp, "k %ld %d\n", turns, ch);
+    fflush(rec_fp);
+}
+
+/*
+ * end_record:
+ *	Write down how the game ended, so that a replay can be checked
+ */
+
+void
+end_record()
+{
+    if (rec_fp == NULL)
+	return;
+    fprintf(rec_fp, "e %ld %d %d %d %d\n", turns, level, max_level, purse,
+	pstats.s_hpt);
+    fclose(rec_fp);
+    rec_fp = NULL;
+}
+
+/*
+ * rep_line:
+ *	Read the value of a header line, without its newline
+ */
+
+static bool
+rep_line(char *name, char *buf)
+{
+    char line[2 * MAXSTR];
+    size_t len;
+
+    if (fgets(line, sizeof line, rep_fp) == NULL)
+	return FALSE;
+    len = strlen(line);
+    if (len > 0 && line[len - 1] == '\n')
+	line[--len] = '\0';
+    len = strlen(name);
+    if (strncmp(line, name, len) != 0 || (line[len] != ' ' && line[len] != '\0'))
+	return FALSE;
+    strncpy(buf, line[len] == '\0' ? "" : &line[len + 1], MAXSTR - 1);
+    buf[MAXSTR - 1] = '\0';
+    return TRUE;
+}
+
+/*
+ * rep_opts_in:
+ *	Take the recorded options, leaving out the files that only the
+ *	recorded game should have written to or read from, and the
+ *	screen recording and watch file, since a replay draws nothing
+ */
+
+static void
+rep_opts_in()
+{
+    char buf[MAXSTR];
+
+    strcpy(buf, rep_opts);
+    parse_opts(buf);
+    rec_file[0] = '\0';
+    obs_file[0] = '\0';
+    act_file[0] = '\0';
+    tty_file[0] = '\0';
+    watch_file[0] = '\0';
+}
+
+/*
+ * start_replay:
+ *	Get ready to play back a recorded game: its seed, its name and
+ *	its options instead of ours
+ */
+
+bool
+start_replay(char *name)
+{
+    char buf[MAXSTR], kind[MAXSTR];
+
+    if ((rep_fp = fopen(name, "r")) == NULL)
+    {
+	perror(name);
+	return FALSE;
+    }
+    if (!rep_line(REC_MAGIC, buf) || !rep_line("version", buf))
+    {
+	printf(msg_get("MSG_REPLAY_NOT_RECORDING"), name);
+	printf("\n");
+	return FALSE;
+    }
+    if (strcmp(buf, release) != 0)
+    {
+	printf(msg_get("MSG_REPLAY_OTHER_VERSION"), buf);
+	printf("\n");
+	return FALSE;
+    }
+    if (!rep_line("seed", buf) || sscanf(buf, "%d %s", &dnum, kind) != 2
+	|| !rep_line("name", whoami) || !rep_line("options", rep_opts)
+	|| !rep_line("flags", buf) || sscanf(buf, "%d %d %d %d", &rep_flags[0],
+	    &rep_flags[1], &rep_flags[2], &rep_flags[3]) != 4)
+    {
+	printf(msg_get("MSG_REPLAY_NOT_RECORDING"), name);
+	printf("\n");
+	return FALSE;
+    }
+    rep_opts_in();
+    fast_rng = (strcmp(kind, "fast") == 0);
+    replaying = TRUE;
+    headless = TRUE;
+    noscore = TRUE;
+    return TRUE;
+}
+
+/*
+ * replay_opts:
+ *	Set the options as playit() had them in the recorded game
+ */
+
+void
+replay_opts()
+{
+    rep_opts_in();
+    terse = (bool) rep_flags[0];
+    jump = (bool) rep_flags[1];
+    see_floor = (bool) rep_flags[2];
+    inv_type = rep_flags[3];
+}
+
+/*
+ * replay_screen:
+ *	Start curses on a screen that goes nowhere, just the size of
+ *	the map
+ */
+
+void
+replay_screen()
+{
+    static char lines[20], cols[20];
+    FILE *fp;
+
+    sprintf(lines, "LINES=%d", NUMLINES);
+    sprintf(cols, "COLUMNS=%d", NUMCOLS);
+    putenv(lines);
+    putenv(cols);
+    if ((fp = fopen(NULL_DEVICE, "w")) == NULL
+	|| newterm("vt100", fp, stdin) == NULL)
+    {
+	perror(NULL_DEVICE);
+	exit(1);
+    }
+}
+
+/*
+ * replay_done:
+ *	Say how the replay went and leave
+ */
+
+static void
+replay_done(const char *how, int st)
+{
+    if (!isendwin())
+	endwin();
+    printf(msg_get(how), nkeys, turns, level, max_level, purse, pstats.s_hpt);
+    printf("\n");
+    fclose(rep_fp);
+    resetltchars();
+    exit(st);
+}
+
+/*
+ * end_replay:
+ *	The game is over; it went right if it ended just where the
+ *	recorded one did, in the same shape.  A game that was saved
+ *	stops at the save, so the rest of its keys are skipped.
+ */
+
+void
+end_replay(bool skip_rest)
+{
+    char kind;
+    long t;
+    int lev, maxlev, gold, hp;
+
+    for (;;)
+    {
+	if (fscanf(rep_fp, " %c %ld", &kind, &t) != 2)
+	    replay_done("MSG_REPLAY_CUT_SHORT", 0);
+	if (kind != 'k')
+	    break;
+	if (!skip_rest || fscanf(rep_fp, "%*d") == EOF)
+	    replay_done("MSG_REPLAY_DIFFERENT", 1);
+    }
+    if (kind == 'e'
+	&& fscanf(rep_fp, "%d %d %d %d", &lev, &maxlev, &gold, &hp) == 4
+	&& t == turns && lev == level && maxlev == max_level
+	&& gold == purse && hp == pstats.s_hpt)
+	replay_done("MSG_REPLAY_SAME", 0);
+    replay_done("MSG_REPLAY_DIFFERENT", 1);
+}
+
+/*
+ * replay_key:
+ *	The next key from the recording.  Being asked for one on another
+ *	turn than it was typed on, or after the game should have ended,
+ *	means this game has gone another way.
+ */
+
+char
+replay_key()
+{
+    char kind;
+    long t;
+    int ch;
+
+    if (fscanf(rep_fp, " %c %ld", &kind, &t) != 2)
+	replay_done("MSG_REPLAY_CUT_SHORT", 0);
+    if (kind != 'k' || t != turns || fscanf(rep_fp, "%d", &ch) != 1)
+	replay_done("MSG_REPLAY_DIFFERENT", 1);
+    nkeys++;
+    return (char) ch;
+}
@@ -138,7 +138,11 @@ gethand()
 	    msg(msg_get("MSG_RING_LEFT_OR_RIGHT"));
 	else
 	    msg(msg_get("MSG_RING_LEFT_OR_RIGHT_HAND"));
-	if ((c = readchar()) == ESCAPE)
+	if (action != NULL)
+	    c = act_key(&action->a_hand);
+	else
+	    c = readchar();
+	if (c == ESCAPE)
 	    return -1;
 	mpos = 0;
 	if (c == 'l' || c == 'L')
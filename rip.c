@@ -140,6 +140,20 @@ score(int amount, int flags, char monst)
     reason[2] = msg_get("MSG_TOTAL_WINNER");
     reason[3] = msg_get("MSG_KILLED_WITH_AMULET");
 
+    /*
+     * A replay has no score to post and nobody to show the list to,
+     * and a game on a server only has its own screen to show
+     */
+    if (replaying)
+	my_exit(0);
+    end_record();		/* What is typed from here on is not played */
+    if (serving)
+    {
+	mvaddstr(LINES - 1, 0, msg_get("MSG_PRESS_RETURN_TO_CONTINUE"));
+	readchar();
+	my_exit(0);
+    }
+
     start_score();
 
  if (flags >= 0
@@ -150,7 +164,10 @@ score(int amount, int flags, char monst)
     {
 	mvaddstr(LINES - 1, 0 , msg_get("MSG_PRESS_RETURN_TO_CONTINUE"));
         refresh();
-        wgetnstr(stdscr,prbuf,80);
+	put_ttyrec(TRUE);
+	put_watch();
+	prbuf[0] = '\0';
+	get_str(prbuf, stdscr);
  	endwin();
         printf("\n");
         resetltchars();
@@ -14,11 +14,13 @@
 #define ROGUE_H
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdarg.h>
 #include <curses.h>
 
 #include "extern.h"
+#include "observe.h"
 
 #undef lines
 
@@ -27,16 +29,51 @@
 /*
  * Maximum number of different things
  */
-#define MAXROOMS	9
 #define MAXTHINGS	9
 #define MAXOBJ		9
 #define MAXPACK		23
 #define MAXTRAPS	10
 #define AMULETLEVEL	26
 #define	NUMTHINGS	7	/* number of types of things */
-#define MAXPASS		13	/* upper limit on number of passages */
+#define MSGLOG		100	/* messages remembered */
+#define NAMELEN		96	/* longest name kept with an object */
+
+/*
+ * Size of the map.  The usual 80x24 can be made bigger when building,
+ * e.g. with -DNUMLINES=60 -DNUMCOLS=200.  Rooms are laid out on a grid
+ * of ROOMSX by ROOMSY blocks of about 26x8 spots each, and there can
+ * be a passage for every pair of rooms next to each other on it.
+ */
+#ifndef NUMLINES
 #define	NUMLINES	24
+#endif
+#ifndef NUMCOLS
 #define	NUMCOLS		80
+#endif
+#if NUMLINES < 24 || NUMCOLS < 80
+#error "the map must be at least 80x24"
+#endif
+#ifndef ROOMSX
+#define ROOMSX		(NUMCOLS / 26)	/* rooms across the map */
+#endif
+#ifndef ROOMSY
+#define ROOMSY		(NUMLINES / 8)	/* rooms down the map */
+#endif
+#define MAXROOMS	(ROOMSX * ROOMSY)
+#define MAXPASS		(ROOMSY * (ROOMSX - 1) + ROOMSX * (ROOMSY - 1) + 1)
+					/* upper limit on number of passages */
+#if MAXPASS > 256
+#error "too many passages for p_pnum"
+#endif
+#if NUMLINES <= 32			/* log2 of MAXLINES, for INDEX() */
+#define LINESHIFT	5
+#elif NUMLINES <= 64
+#define LINESHIFT	6
+#elif NUMLINES <= 128
+#define LINESHIFT	7
+#else
+#error "the map can be at most 128 lines"
+#endif
 #define STATLINE		(NUMLINES - 1)
 #define BORE_LEVEL	50
 
@@ -79,10 +116,13 @@
 #define ISRING(h,r)	(cur_ring[h] != NULL && cur_ring[h]->o_which == r)
 #define ISWEARING(r)	(ISRING(LEFT, r) || ISRING(RIGHT, r))
 #define ISMULT(type) 	(type == POTION || type == SCROLL || type == FOOD)
-#define INDEX(y,x)	(&places[((x) << 5) + (y)])
-#define chat(y,x)	(places[((x) << 5) + (y)].p_ch)
-#define flat(y,x)	(places[((x) << 5) + (y)].p_flags)
-#define moat(y,x)	(places[((x) << 5) + (y)].p_monst)
+#define INDEX(y,x)	(&places[((x) << LINESHIFT) + (y)])
+#define chat(y,x)	(places[((x) << LINESHIFT) + (y)].p_ch)
+#define flat(y,x)	(places[((x) << LINESHIFT) + (y)].p_flags)
+#define moat(y,x)	(places[((x) << LINESHIFT) + (y)].p_monst)
+#define obat(y,x)	(places[((x) << LINESHIFT) + (y)].p_obj)
+#define shown(y,x)	(places[((x) << LINESHIFT) + (y)].p_show)
+#define pnat(y,x)	(places[((x) << LINESHIFT) + (y)].p_pnum)
 #define unc(cp)		(cp).y, (cp).x
 #ifdef MASTER
 #define debug		if (wizard) msg
@@ -191,7 +231,7 @@
 #define F_DROPPED	0x20		/* object was dropped here */
 #define F_LOCKED	0x20		/* door is locked */
 #define F_REAL		0x10		/* what you see is what you get */
-#define F_PNUM		0x0f		/* passage number mask */
+#define F_PNUM		0x0f		/* passage number, in save files */
 #define F_TMASK		0x07		/* trap number mask */
 
 /*
@@ -338,6 +378,65 @@ typedef struct {
 
 typedef unsigned int str_t;
 
+/*
+ * State of a random number generator.  Every game has its own, so
+ * nothing stops several from running in one process.  RNG_LEGACY is
+ * the original 16-bit generator, which still digs the same dungeons
+ * from the same seeds; RNG_FAST is a counter based 64-bit generator.
+ */
+#define RNG_LEGACY	0
+#define RNG_FAST	1
+
+typedef struct {
+    int r_kind;				/* Which generator this is */
+    int r_seed;				/* Legacy state, or the game seed */
+    uint64_t r_key;			/* Key of the fast generator */
+    uint64_t r_state;			/* Count of the fast generator */
+} RNG;
+
+/*
+ * Separate random number streams, so that what one part of the game
+ * draws does not change what another gets.  Only the fast generator
+ * splits them; with the legacy one they are all RS_MAIN.
+ */
+#define RS_MAIN		0	/* Everything not below */
+#define RS_LEVEL	1	/* Digging levels */
+#define RS_FIGHT	2	/* Combat */
+#define RS_MONST	3	/* Monster movement */
+#define RS_LOOK		4	/* What hallucinating shows */
+#define NSTREAMS	5
+
+/*
+ * What a new level is dug from, so that a level that has been dug can
+ * be kept and handed back the next time the same one is asked for
+ */
+#define LK_AMULET	0x1	/* He has the amulet */
+#define LK_OLD		0x2	/* and has been this deep before */
+#define LK_AGGR		0x4	/* He is wearing aggravate monster */
+
+typedef struct {
+    RNG k_rng;				/* Level stream before digging */
+    int k_level;			/* How deep it is */
+    int k_food;				/* no_food before digging */
+    int k_flags;			/* LK_* above */
+} LEVKEY;
+
+/*
+ * A maze being dug.  Its cells are two spots apart, and each one that
+ * has been dug out is marked by one bit of m_used.  The cells still
+ * being dug from are kept on m_stack, so no recursion is needed and
+ * nothing about the maze lives anywhere else.
+ */
+#define MAZECELLS	((NUMLINES / 2 + 1) * (NUMCOLS / 2 + 1))
+
+typedef struct {
+    coord m_pos;			/* Map position of cell (0, 0) */
+    coord m_max;			/* Largest cell offsets */
+    int m_depth;			/* Cells on m_stack */
+    coord m_stack[MAZECELLS];		/* Cells still being dug from */
+    uint32_t m_used[(MAZECELLS + 31) / 32];	/* Cells already dug */
+} MAZE;
+
 /*
  * Stuff about objects
  */
@@ -360,6 +459,7 @@ struct room {
     short r_flags;			/* info about the room */
     int r_nexits;			/* Number of exits */
     coord r_exit[12];			/* Where the exits are */
+    union thing *r_monst;		/* Monsters in the room */
 };
 
 /*
@@ -375,6 +475,20 @@ struct stats {
     int  s_maxhp;			/* Max hit points */
 };
 
+/*
+ * What the name kept with an object was made from; it is made again
+ * once any of this is different
+ */
+typedef struct {
+    int nk_gen;				/* Names made since were forgotten */
+    int nk_type, nk_which, nk_count;	/* The object itself */
+    int nk_hplus, nk_dplus, nk_arm, nk_flags;
+    char *nk_label;
+    char *nk_guess;			/* What the player knows of its kind */
+    bool nk_know;
+    bool nk_terse;			/* How long a name it got */
+} NAMEKEY;
+
 /*
  * Structure for monsters and player
  */
@@ -392,6 +506,8 @@ union thing {
 	struct room *_t_room;		/* Current room for thing */
 	union thing *_t_pack;		/* What the thing is carrying */
         int _t_reserved;
+	union thing *_t_rnext, *_t_rprev; /* Link in room's monster list */
+	int _t_seq;			/* Higher the nearer the front of mlist */
     } _t;
     struct {
 	union thing *_l_next, *_l_prev;	/* Next pointer in link */
@@ -410,6 +526,10 @@ union thing {
 	int _o_flags;			/* information about objects */
 	int _o_group;			/* group number for this object */
 	char *_o_label;			/* Label for object */
+	union thing *_o_claim;		/* Monster running to pick it up */
+	union thing *_o_under;		/* Next object down on its spot */
+	NAMEKEY _o_invkey;		/* What _o_invname was made from */
+	char _o_invname[NAMELEN];	/* Its name, as inv_name() made it */
     } _o;
 };
 
@@ -428,6 +548,9 @@ typedef union thing THING;
 #define t_pack		_t._t_pack
 #define t_room		_t._t_room
 #define t_reserved      _t._t_reserved
+#define t_rnext		_t._t_rnext
+#define t_rprev		_t._t_rprev
+#define t_seq		_t._t_seq
 #define o_type		_o._o_type
 #define o_pos		_o._o_pos
 #define o_text		_o._o_text
@@ -445,6 +568,10 @@ typedef union thing THING;
 #define o_flags		_o._o_flags
 #define o_group		_o._o_group
 #define o_label		_o._o_label
+#define o_claim		_o._o_claim
+#define o_under		_o._o_under
+#define o_invkey	_o._o_invkey
+#define o_invname	_o._o_invname
 
 /*
  * describe a place on the level map
@@ -452,9 +579,25 @@ typedef union thing THING;
 typedef struct {
     char p_ch;
     char p_flags;
+    unsigned char p_pnum;		/* Which passage this spot is in */
     THING *p_monst;
+    THING *p_obj;
+    chtype p_show;			/* What should be on the screen */
+    chtype p_drawn;			/* What curses was last given */
 } PLACE;
 
+/*
+ * Where one piece of what a game changes lives, so that a process
+ * can keep many games and take turns running them
+ */
+typedef struct {
+    void *gv_addr;
+    size_t gv_size;
+} GAMEVAR;
+
+#define GV(v)		{ (void *) &(v), sizeof (v) }
+#define GV_END		{ NULL, 0 }
+
 /*
  * Array containing information on all the various types of monsters
  */
@@ -469,25 +612,37 @@ struct monster {
  * External variables
  */
 
-extern bool	after, again, allscore, amulet, door_stop, fight_flush,
-		firstmove, has_hit, inv_describe, jump, kamikaze,
-		lower_msg, move_on, msg_esc, pack_used[],
-		passgo, playing, q_comm, running, save_msg, see_floor,
-		seenstairs, stat_msg, terse, to_death, tombstone;
-
-extern char	dir_ch, file_name[], home[], huh[], *inv_t_name[],
-		l_last_comm, l_last_dir, last_comm, last_dir, *Numname,
-		outbuf[], *p_colors[], *r_stones[], *release, runch,
-		*s_names[], take, *tr_name[], *ws_made[], *ws_type[];
-
-extern int	a_class[], count, food_left, hungry_state, inpack,
-		inv_type, lastscore, level, max_hit, max_level, mpos,
+extern bool	after, again, allscore, amulet, animate, door_stop,
+		fast_rng, fight_flush, firstmove, has_hit, headless,
+		inv_describe, jump, kamikaze, level_cache,
+		lower_msg, more_msg, move_on, msg_esc, pack_used[], passgo,
+		playing, pre_dig, q_comm, replaying, restored, running,
+		save_msg, see_floor, seenstairs, serving, stat_msg, terse,
+		to_death, tombstone;
+
+extern char	act_file[], cache_dir[], dir_ch, file_name[], home[], huh[], obs_file[],
+		*inv_t_name[], l_last_comm, l_last_dir, last_comm, last_dir,
+		*Numname, outbuf[], *p_colors[], *r_stones[], rec_file[],
+		*release, runch, *s_names[], take, *tr_name[], tty_file[],
+		watch_file[], *ws_made[], *ws_type[];
+
+extern int	a_class[], count, food_left, frame_rate, hungry_state, inpack,
+		inv_type, lastscore, level, max_hit, max_level, mon_seq, mpos,
 		n_objs, no_command, no_food, no_move, noscore, ntraps, purse,
 		quiet, vf_hit;
 
 extern unsigned int	numscores;
 
-extern int	dnum, e_levels[], seed;
+extern long	floor_tries, room_tries, turns;
+
+extern int	dnum, e_levels[];
+
+extern RNG	*rng, *streams;
+
+extern ACTION	*action;
+
+extern GAMEVAR	command_vars[], extern_vars[], io_vars[], levels_vars[],
+		misc_vars[], sticks_vars[], things_vars[];
 
 extern WINDOW	*hw;
 
@@ -515,12 +670,13 @@ extern struct obj_info	arm_info[], pot_info[], ring_info[],
 void	_attach(THING **list, THING *item);
 void	_detach(THING **list, THING *item);
 void	_free_list(THING **ptr);
+char	act_key(char *cp);
 void	addmsg(const char *fmt, ...);
 bool	add_haste(bool potion);
 void	add_pack(THING *obj, bool silent);
 void	add_pass();
 void	add_str(str_t *sp, int amt);
-void	accnt_maze(int y, int x, int ny, int nx);
+void	attach_obj(THING *obj);
 void	aggravate();
 int	attack(THING *mp);
 void	badcheck(char *name, struct obj_info *info, int bound);
@@ -531,6 +687,7 @@ bool	cansee(int y, int x);
 int	center(char *str);
 void	chg_str(int amt);
 void	check_level();
+void	clear_level();
 void	conn(int r1, int r2);
 void	command();
 void	create_obj();
@@ -538,13 +695,17 @@ void	create_obj();
 void	current(THING *cur, const char *how, const char *where);
 void	d_level();
 void	death(char monst);
+void	detach_obj(THING *obj);
+void	dig_ahead();
+void	dig_level();
 char	death_monst();
-void	dig(int y, int x);
+void	dig(MAZE *mp, int y, int x);
 void	discard(THING *item);
 void	discovered();
 int	dist(int y1, int x1, int y2, int x2);
 int	dist_cp(coord *c1, coord *c2);
 int	do_chase(THING *th);
+void	do_action(ACTION *ap);
 void	do_daemons(int flag);
 void	do_fuses(int flag);
 void	do_maze(struct room *rp);
@@ -564,7 +725,12 @@ void	drop();
 void	eat();
 size_t  encread(char *start, size_t size, FILE *inf);
 size_t	encwrite(char *start, size_t size, FILE *outf);
+size_t	game_size();
 int	endmsg();
+void	end_record();
+void	end_replay(bool skip_rest);
+void	end_ttyrec();
+void	end_watch();
 void	enter_room(coord *cp);
 void	erase_lamp(coord *pos, struct room *rp);
 int	exp_add(THING *tp);
@@ -575,8 +741,13 @@ char    floor_at();
 char	floor_ch();
 void	flush_type();
 int	fight(coord *mp, THING *weap, bool thrown);
+void	flush_map();
+void	flush_levels();
 void	fix_stick(THING *cur);
+void	forget_names();
 void	fuse(void (*func)(), int arg, int time, int type);
+void	game_load(char *blob);
+void	game_save(char *blob);
 bool	get_dir();
 int	gethand();
 void	give_pack(THING *tp);
@@ -589,9 +760,12 @@ void	look(bool wakeup);
 int	hit_monster(int y, int x, THING *obj);
 void	identify();
 void	illcom(int ch);
+void	index_objs();
+void	index_rooms();
 void	init_check();
 void	init_colors();
 void	init_fruit();
+void	init_game();
 void	init_help();
 void	init_inv_t_name();
 void	init_options();
@@ -605,9 +779,11 @@ void	init_probs();
 void	init_rainbow();
 void	init_rings();
 void	init_scrolls();
+int	init_seed(int argc, char **argv);
 void	init_sticks();
 void	init_stones();
 void	init_stones_array();
+void	init_tables();
 void	init_traps();
 void	init_wood_array();
 void	init_armors();
@@ -616,7 +792,9 @@ void	init_weapon(THING *weap, int which);
 bool	inventory(THING *list, int type);
 void	invis_on();
 void	killed(THING *tp, bool pr);
+void	keep_level();
 void	kill_daemon(void (*func)());
+bool	load_level();
 bool	lock_sc();
 void	miss(const char *er, const char *ee, bool noend);
 void	missile(int ydelta, int xdelta);
@@ -624,10 +802,16 @@ void	money(int value);
 int	move_monst(THING *tp);
 void	move_msg(THING *obj);
 int	msg(const char *fmt, ...);
+int	msg_count();
+void	msg_history();
 void	nameit(THING *obj, int type, char *which, struct obj_info *op, char *(*prfunc)(THING *));
 void	new_level();
+void	mvshow(int y, int x, chtype ch);
 void	new_monster(THING *tp, char type, coord *cp);
+void	no_files();
+char	next_cmd();
 void	numpass(int y, int x);
+void	observe();
 void	option();
 void	open_score();
 void	parse_opts(char *str);
@@ -640,48 +824,76 @@ void	pr_spec(struct obj_info *info, int nitems);
 void	pr_list();
 void	put_bool(void *b);
 void	put_inv_t(void *ip);
+void	put_num(void *ip);
 void	put_str(void *str);
 void	put_things();
 void	putpass(coord *cp);
+void	put_ttyrec(bool waiting);
+void	put_watch();
 void	quaff();
 void	raise_level();
 char	randmonster(bool wander);
 void	read_scroll();
+void	read_spots(uint32_t *sp, int lines, int cols, int *cyp, int *cxp);
+void	record_key(char ch);
 void    relocate(THING *th, coord *new_loc);
 void	remove_mon(coord *mp, THING *tp, bool waskill);
+void	room_attach(THING *tp);
+void	room_detach(THING *tp);
+void	replay_opts();
+void	replay_screen();
 void	reset_last();
 bool	restore(char *file, char **envp);
 int	ring_eat(int hand);
 void	ring_on();
 void	ring_off();
 int	rnd(int range);
+void	rng_block(RNG *rp, uint32_t *buf, int n);
+void	rng_fork(RNG *rp, RNG *from, int stream, int n);
+void	rng_init(RNG *rp, int kind, int seed);
+void	rng_level(int depth);
+int	rng_next(RNG *rp);
+void	rng_seed(int kind, int seed);
+int	rng_use(int which);
 int	rnd_room();
 int	roll(int number, int sides);
+void	roll_n(int *out, int n, int number, int sides);
 int	rs_save_file(FILE *savef);
 int	rs_restore_file(FILE *inf);
+int	rs_read_level(FILE *inf, LEVKEY *kp, int *first, int *last);
+int	rs_write_level(FILE *savef, LEVKEY *kp, int first);
 void	runto(coord *runner);
 void	rust_armor(THING *arm);
 int	save(int which);
 void	save_file(FILE *savef);
 void	save_game();
+bool	same_key(LEVKEY *k1, LEVKEY *k2);
 int	save_throw(int which, THING *tp);
 void	score(int amount, int flags, char monst);
 void	search();
+void	serve(char *path, int workers);
+void	session_end();
+void	session_flush();
+void	set_dest(THING *tp, coord *dest);
 void	set_know(THING *obj, struct obj_info *info);
 void	set_oldch(THING *tp, coord *cp);
 void	setup();
 void	shell();
+void	show_frame();
 bool	show_floor();
 void	show_map();
 void	show_win(const char *message);
 int	sign(int nm);
 int	spread(int nm);
 void	start_daemon(void (*func)(), int arg, int type);
+void	start_game();
+void	start_record();
 void	start_score();
 void	status();
 int	step_ok(int ch);
 void	strucpy(char *s1, char *s2, int len);
 int	swing(int at_lvl, int op_arm, int wplus);
+void	sync_map();
 void	take_off();
 void	teleport();
 void	total_winner();
@@ -689,16 +901,19 @@ void	thunk(THING *weap, const char *mname, bool noend);
 void	treas_room();
 void	turnref();
 void	u_level();
+void	unclaim(THING *obj);
 void	uncurse(THING *obj);
 void	unlock_sc();
 void	vert(struct room *rp, int startx);
 void	wait_for(int ch);
+void	wipe_status();
 THING  *wake_monster(int y, int x);
 void	wanderer();
 void	waste_time();
 void	wear();
 void	whatis(bool insist, int type);
 void	wield();
+void	write_obs(FILE *fp);
 
 bool	chase(THING *tp, coord *ee);
 bool	diag_ok(coord *sp, coord *ep);
@@ -712,8 +927,10 @@ bool	pack_room(bool from_floor, THING *obj);
 bool	roll_em(THING *thatt, THING *thdef, THING *weap, bool hurl);
 bool	see_monst(THING *mp);
 bool	seen_stairs();
+bool	start_replay(char *name);
 bool	turn_ok(int y, int x);
 bool	turn_see(bool turn_off);
+bool	watch(char *name);
 bool	is_current(THING *obj);
 int	passwd();
 
@@ -721,6 +938,8 @@ char	be_trapped(coord *tc);
 char	floor_ch();
 char	pack_char();
 char	readchar();
+char	replay_key();
+char	session_key();
 char	rnd_thing();
 
 char	*charge_str(THING *obj);
@@ -728,6 +947,7 @@ const char	*choose_str(const char *ts, const char *ns);
 char	*inv_name(THING *obj, bool drop);
 char	*nullstr(THING *ignored);
 char	*num(int n1, int n2, char type);
+char	*old_msg(int n, long *turnp);
 char	*ring_num(THING *obj);
 const char	*set_mname(THING *tp);
 char	*vowelstr(const char *str);
@@ -738,6 +958,8 @@ int	get_num(void *vp, WINDOW *win);
 int	get_sf(void *vp, WINDOW *win);
 int	get_str(void *vopt, WINDOW *win);
 int	trip_ch(int y, int x, int ch);
+int	tty_diff(uint32_t *now, uint32_t *was, int lines, int cols,
+		 int *yp, int *xp, int cy, int cx, char *out);
 
 coord	*find_dest(THING *tp);
 coord	*rndmove(THING *who);
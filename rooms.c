@@ -11,16 +11,12 @@
  */
 
 #include <ctype.h>
+#include <string.h>
 #include <curses.h>
 #include "rogue.h"
 
-typedef struct spot {		/* position matrix for maze positions */
-	int	nexits;
-	coord	exits[4];
-	int	used;
-} SPOT;
-
 #define GOLDGRP 1
+#define FLOOR_TRIES 8	/* misses before find_floor() counts spots */
 
 /*
  * do_rooms:
@@ -38,8 +34,8 @@ do_rooms()
     coord bsze;				/* maximum room size */
     coord mp;
 
-    bsze.x = NUMCOLS / 3;
-    bsze.y = NUMLINES / 3;
+    bsze.x = NUMCOLS / ROOMSX;
+    bsze.y = NUMLINES / ROOMSY;
     /*
      * Clear things for a new level
      */
@@ -52,7 +48,7 @@ do_rooms()
     /*
      * Put the gone rooms, if any, on the level
      */
-    left_out = rnd(4);
+    left_out = rnd(MAXROOMS / 3 + 1);
     for (i = 0; i < left_out; i++)
 	rooms[rnd_room()].r_flags |= ISGONE;
     /*
@@ -63,8 +59,8 @@ do_rooms()
 	/*
 	 * Find upper left corner of box that this room goes in
 	 */
-	top.x = (i % 3) * bsze.x + 1;
-	top.y = (i / 3) * bsze.y;
+	top.x = (i % ROOMSX) * bsze.x + 1;
+	top.y = (i / ROOMSX) * bsze.y;
 	if (rp->r_flags & ISGONE)
 	{
 	    /*
@@ -122,23 +118,32 @@ do_rooms()
 
 	    gold = new_item();
 	    gold->o_goldval = rp->r_goldval = GOLDCALC;
-	    find_floor(rp, &rp->r_gold, FALSE, FALSE);
-	    gold->o_pos = rp->r_gold;
-	    chat(rp->r_gold.y, rp->r_gold.x) = GOLD;
-	    gold->o_flags = ISMANY;
-	    gold->o_group = GOLDGRP;
-	    gold->o_type = GOLD;
-	    attach(lvl_obj, gold);
+	    if (find_floor(rp, &rp->r_gold, FALSE, FALSE))
+	    {
+		gold->o_pos = rp->r_gold;
+		chat(rp->r_gold.y, rp->r_gold.x) = GOLD;
+		gold->o_flags = ISMANY;
+		gold->o_group = GOLDGRP;
+		gold->o_type = GOLD;
+		attach_obj(gold);
+	    }
+	    else
+	    {
+		rp->r_goldval = 0;
+		discard(gold);
+	    }
 	}
 	/*
 	 * Put the monster in
 	 */
 	if (rnd(100) < (rp->r_goldval > 0 ? 80 : 25))
 	{
-	    tp = new_item();
-	    find_floor(rp, &mp, FALSE, TRUE);
-	    new_monster(tp, randmonster(FALSE), &mp);
-	    give_pack(tp);
+	    if (find_floor(rp, &mp, FALSE, TRUE))
+	    {
+		tp = new_item();
+		new_monster(tp, randmonster(FALSE), &mp);
+		give_pack(tp);
+	    }
 	}
     }
 }
@@ -205,61 +210,72 @@ horiz(struct room *rp, int starty)
  *	Dig a maze
  */
 
-static int	Maxy, Maxx, Starty, Startx;
-
-static SPOT	maze[NUMLINES/3+1][NUMCOLS/3+1];
-
-
 void
 do_maze(struct room *rp)
 {
-    SPOT *sp;
+    MAZE maze;
     int starty, startx;
-    static coord pos;
-
-    for (sp = &maze[0][0]; sp <= &maze[NUMLINES / 3][NUMCOLS / 3]; sp++)
-    {
-	sp->used = FALSE;
-	sp->nexits = 0;
-    }
+    coord pos;
 
-    Maxy = rp->r_max.y;
-    Maxx = rp->r_max.x;
-    Starty = rp->r_pos.y;
-    Startx = rp->r_pos.x;
+    maze.m_pos = rp->r_pos;
+    maze.m_max = rp->r_max;
     starty = (rnd(rp->r_max.y) / 2) * 2;
     startx = (rnd(rp->r_max.x) / 2) * 2;
-    pos.y = starty + Starty;
-    pos.x = startx + Startx;
+    pos.y = starty + maze.m_pos.y;
+    pos.x = startx + maze.m_pos.x;
     putpass(&pos);
-    dig(starty, startx);
+    dig(&maze, starty, startx);
 }
 
+/*
+ * maze_cell:
+ *	Find the bit of m_used for a cell of the maze
+ */
+
+static int
+maze_cell(MAZE *mp, int y, int x)
+{
+    return (y / 2) * (mp->m_max.x / 2 + 1) + x / 2;
+}
+
+#define maze_used(mp,c)	((mp)->m_used[(c) / 32] & (1u << ((c) % 32)))
+
 /*
  * dig:
- *	Dig out from around where we are now, if possible
+ *	Dig out the maze from the cell at offset (y, x), which is already
+ *	dug.  Keep going from the newest cell that still has a neighbor
+ *	not dug yet, backing up a cell whenever one runs out.
  */
 
 void
-dig(int y, int x)
+dig(MAZE *mp, int y, int x)
 {
-    coord *cp;
-    int cnt, newy, newx, nexty = 0, nextx = 0;
-    static coord pos;
+    coord *cp, *here;
+    int cnt, c, newy, newx, nexty = 0, nextx = 0;
+    coord pos;
     static coord del[4] = {
 	{2, 0}, {-2, 0}, {0, 2}, {0, -2}
     };
 
-    for (;;)
+    memset(mp->m_used, 0, sizeof mp->m_used);
+    c = maze_cell(mp, y, x);
+    mp->m_used[c / 32] |= 1u << (c % 32);
+    mp->m_stack[0].y = y;
+    mp->m_stack[0].x = x;
+    mp->m_depth = 1;
+    while (mp->m_depth > 0)
     {
+	here = &mp->m_stack[mp->m_depth - 1];
+	y = here->y;
+	x = here->x;
 	cnt = 0;
 	for (cp = del; cp <= &del[3]; cp++)
 	{
 	    newy = y + cp->y;
 	    newx = x + cp->x;
-	    if (newy < 0 || newy > Maxy || newx < 0 || newx > Maxx)
+	    if (newy < 0 || newy > mp->m_max.y || newx < 0 || newx > mp->m_max.x)
 		continue;
-	    if (flat(newy + Starty, newx + Startx) & F_PASS)
+	    if (maze_used(mp, maze_cell(mp, newy, newx)))
 		continue;
 	    if (rnd(++cnt) == 0)
 	    {
@@ -268,50 +284,103 @@ dig(int y, int x)
 	    }
 	}
 	if (cnt == 0)
-	    return;
-	accnt_maze(y, x, nexty, nextx);
-	accnt_maze(nexty, nextx, y, x);
-	if (nexty == y)
-	{
-	    pos.y = y + Starty;
-	    if (nextx - x < 0)
-		pos.x = nextx + Startx + 1;
-	    else
-		pos.x = nextx + Startx - 1;
-	}
-	else
 	{
-	    pos.x = x + Startx;
-	    if (nexty - y < 0)
-		pos.y = nexty + Starty + 1;
-	    else
-		pos.y = nexty + Starty - 1;
+	    mp->m_depth--;
+	    continue;
 	}
+	pos.y = (y + nexty) / 2 + mp->m_pos.y;
+	pos.x = (x + nextx) / 2 + mp->m_pos.x;
 	putpass(&pos);
-	pos.y = nexty + Starty;
-	pos.x = nextx + Startx;
+	pos.y = nexty + mp->m_pos.y;
+	pos.x = nextx + mp->m_pos.x;
 	putpass(&pos);
-	dig(nexty, nextx);
+	c = maze_cell(mp, nexty, nextx);
+	mp->m_used[c / 32] |= 1u << (c % 32);
+	here[1].y = nexty;
+	here[1].x = nextx;
+	mp->m_depth++;
     }
 }
 
 /*
- * accnt_maze:
- *	Account for maze exits
+ * room_attach:
+ *	Add a monster to the list of monsters in its room.  The list is
+ *	kept in the order of mlist, so that walking it does things to
+ *	the monsters in the same order walking mlist would.
  */
 
 void
-accnt_maze(int y, int x, int ny, int nx)
+room_attach(THING *tp)
 {
-    SPOT *sp;
-    coord *cp;
-
-    sp = &maze[y][x];
-    for (cp = sp->exits; cp < &sp->exits[sp->nexits]; cp++)
-	if (cp->y == ny && cp->x == nx)
-	    return;
-    cp->y = ny;
-    cp->x = nx;
+    struct room *rp;
+    THING *mp, *prev;
+
+    if ((rp = tp->t_room) == NULL)
+	return;
+    prev = NULL;
+    for (mp = rp->r_monst; mp != NULL && mp->t_seq > tp->t_seq;
+	mp = mp->t_rnext)
+	    prev = mp;
+    tp->t_rprev = prev;
+    tp->t_rnext = mp;
+    if (mp != NULL)
+	mp->t_rprev = tp;
+    if (prev != NULL)
+	prev->t_rnext = tp;
+    else
+	rp->r_monst = tp;
+}
+
+/*
+ * room_detach:
+ *	Take a monster off the list of monsters in its room
+ */
+
+void
+room_detach(THING *tp)
+{
+    struct room *rp;
+
+    if ((rp = tp->t_room) == NULL)
+	return;
+    if (rp->r_monst == tp)
+	rp->r_monst = tp->t_rnext;
+    if (tp->t_rprev != NULL)
+	tp->t_rprev->t_rnext = tp->t_rnext;
+    if (tp->t_rnext != NULL)
+	tp->t_rnext->t_rprev = tp->t_rprev;
+    tp->t_rnext = NULL;
+    tp->t_rprev = NULL;
+}
+
+/*
+ * index_rooms:
+ *	Number the monsters in mlist and rebuild the monster lists of
+ *	all the rooms and passages from it
+ */
+
+void
+index_rooms()
+{
+    struct room *rp;
+    THING *tp, *last;
+
+    for (rp = rooms; rp < &rooms[MAXROOMS]; rp++)
+	rp->r_monst = NULL;
+    for (rp = passages; rp < &passages[MAXPASS]; rp++)
+	rp->r_monst = NULL;
+    mon_seq = 0;
+    last = NULL;
+    for (tp = mlist; tp != NULL; tp = next(tp))
+	last = tp;
+    /*
+     * From the back, so each one goes on the front of its room's list
+     */
+    for (tp = last; tp != NULL; tp = prev(tp))
+    {
+	tp->t_seq = ++mon_seq;
+	room_attach(tp);
+    }
 }
 
 /*
@@ -326,42 +395,105 @@ rnd_pos(struct room *rp, coord *cp)
     cp->y = rp->r_pos.y + rnd(rp->r_max.y - 2) + 1;
 }
 
+/*
+ * floor_ok:
+ *	Is this spot of this room the kind that find_floor() wants
+ */
+
+static bool
+floor_ok(struct room *rp, int y, int x, bool monst)
+{
+    PLACE *pp;
+
+    pp = INDEX(y, x);
+    if (monst)
+	return (pp->p_monst == NULL && step_ok(pp->p_ch));
+    return (pp->p_ch == ((rp->r_flags & ISMAZE) ? PASSAGE : FLOOR));
+}
+
+/*
+ * count_floor:
+ *	Count the spots find_floor() could land on, in rp or in every
+ *	room that is there if rp is NULL.  If which is one of them,
+ *	stop there and leave cp at it.
+ */
+
+static int
+count_floor(struct room *rp, coord *cp, bool monst, int which)
+{
+    struct room *first, *last;
+    int n, y, x;
+
+    if (rp != NULL)
+	first = last = rp;
+    else
+    {
+	first = rooms;
+	last = &rooms[MAXROOMS - 1];
+    }
+    n = 0;
+    for (rp = first; rp <= last; rp++)
+    {
+	if (first != last && (rp->r_flags & ISGONE))
+	    continue;
+	for (y = rp->r_pos.y + 1; y < rp->r_pos.y + rp->r_max.y - 1; y++)
+	    for (x = rp->r_pos.x + 1; x < rp->r_pos.x + rp->r_max.x - 1; x++)
+		if (floor_ok(rp, y, x, monst) && n++ == which)
+		{
+		    cp->y = y;
+		    cp->x = x;
+		    return n;
+		}
+    }
+    return n;
+}
+
 /*
  * find_floor:
  *	Find a valid floor spot in this room.  If rp is NULL, then
- *	pick a new room each time around the loop.
+ *	pick a new room each time around the loop.  Picking spots at
+ *	random can go on a long time on a crowded level, so every
+ *	FLOOR_TRIES misses the spots that would do are counted.  If
+ *	there are none it gives up rather than looking forever; with
+ *	the fast generator it then just picks one of them.  The legacy
+ *	generator keeps picking at random, so that old seeds still dig
+ *	the same levels.
  */
 bool
 find_floor(struct room *rp, coord *cp, int limit, bool monst)
 {
-    PLACE *pp;
-    int cnt;
-    char compchar = 0;
+    int cnt, tries, n;
     bool pickroom;
 
     pickroom = (bool)(rp == NULL);
-
-    if (!pickroom)
-	compchar = ((rp->r_flags & ISMAZE) ? PASSAGE : FLOOR);
     cnt = limit;
+    tries = 0;
     for (;;)
     {
 	if (limit && cnt-- == 0)
 	    return FALSE;
+	floor_tries++;
 	if (pickroom)
-	{
 	    rp = &rooms[rnd_room()];
-	    compchar = ((rp->r_flags & ISMAZE) ? PASSAGE : FLOOR);
-	}
 	rnd_pos(rp, cp);
-	pp = INDEX(cp->y, cp->x);
-	if (monst)
+	if (floor_ok(rp, cp->y, cp->x, monst))
+	    return TRUE;
+	if (++tries % FLOOR_TRIES != 0)
+	    continue;
+	if (pickroom)
+	    rp = NULL;
+	if (rng->r_kind == RNG_LEGACY)
 	{
-	    if (pp->p_monst == NULL && step_ok(pp->p_ch))
-		return TRUE;
+	    if (limit == 0 && count_floor(rp, cp, monst, -1) == 0)
+		return FALSE;
 	}
-	else if (pp->p_ch == compchar)
+	else
+	{
+	    if ((n = count_floor(rp, cp, monst, -1)) == 0)
+		return FALSE;
+	    count_floor(rp, cp, monst, rnd(n));
 	    return TRUE;
+	}
     }
 }
 
@@ -380,36 +512,28 @@ enter_room(coord *cp)
 
     rp = proom = roomin(cp);
     door_open(rp);
-    if (!(rp->r_flags & ISDARK) && !on(player, ISBLIND))
-	for (y = rp->r_pos.y; y < rp->r_max.y + rp->r_pos.y; y++)
+    if (rp->r_flags & ISDARK || on(player, ISBLIND))
+	return;
+    for (y = rp->r_pos.y; y < rp->r_max.y + rp->r_pos.y; y++)
+	for (x = rp->r_pos.x; x < rp->r_max.x + rp->r_pos.x; x++)
 	{
-	    move(y, rp->r_pos.x);
-	    for (x = rp->r_pos.x; x < rp->r_max.x + rp->r_pos.x; x++)
-	    {
-		tp = moat(y, x);
-		ch = chat(y, x);
-		if (tp == NULL)
-		    if (CCHAR(inch()) != ch)
-			addch(ch);
-		    else
-			move(y, x + 1);
-		else
-		{
-		    tp->t_oldch = ch;
-		    if (!see_monst(tp))
-			if (on(player, SEEMONST))
-			{
-			    standout();
-			    addch(tp->t_disguise);
-			    standend();
-			}
-			else
-			    addch(ch);
-		    else
-			addch(tp->t_disguise);
-		}
-	    }
+	    ch = chat(y, x);
+	    if (CCHAR(shown(y, x)) != ch)
+		mvshow(y, x, ch);
 	}
+    /*
+     * Then put back the monsters that are in the room
+     */
+    for (tp = rp->r_monst; tp != NULL; tp = tp->t_rnext)
+    {
+	y = tp->t_pos.y;
+	x = tp->t_pos.x;
+	tp->t_oldch = chat(y, x);
+	if (see_monst(tp))
+	    mvshow(y, x, tp->t_disguise);
+	else if (on(player, SEEMONST))
+	    mvshow(y, x, tp->t_disguise | A_STANDOUT);
+    }
 }
 
 /*
@@ -438,16 +562,15 @@ leave_room(coord *cp)
     else
 	floor = ' ';
 
-    proom = &passages[flat(cp->y, cp->x) & F_PNUM];
+    proom = &passages[pnat(cp->y, cp->x)];
     for (y = rp->r_pos.y; y < rp->r_max.y + rp->r_pos.y; y++)
 	for (x = rp->r_pos.x; x < rp->r_max.x + rp->r_pos.x; x++)
 	{
-	    move(y, x);
-	    switch ( ch = CCHAR(inch()) )
+	    switch ( ch = CCHAR(shown(y, x)) )
 	    {
 		case FLOOR:
 		    if (floor == ' ' && ch != ' ')
-			addch(' ');
+			mvshow(y, x, ' ');
 		    break;
 		default:
 		    /*
@@ -458,13 +581,11 @@ leave_room(coord *cp)
 		    {
 			if (on(player, SEEMONST))
 			{
-			    standout();
-			    addch(ch);
-			    standend();
+			    mvshow(y, x, ch | A_STANDOUT);
 			    break;
 			}
                         pp = INDEX(y,x);
-			addch(pp->p_ch == DOOR ? DOOR : floor);
+			mvshow(y, x, pp->p_ch == DOOR ? DOOR : floor);
 		    }
 	    }
 	}
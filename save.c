@@ -41,6 +41,19 @@ save_game()
     int c;
     auto char buf[MAXSTR];
 
+    /*
+     * A replay stops where the game was saved, and writes nothing
+     */
+    if (replaying)
+	end_replay(TRUE);
+    /*
+     * Nor does a game on a server, which has nowhere of its own
+     */
+    if (serving)
+    {
+	msg(msg_get("MSG_SERVER_NO_SAVE"));
+	return;
+    }
     /*
      * get file name
      */
@@ -223,7 +236,12 @@ restore(char *file, char **envp)
     hw = newwin(LINES, COLS, 0, 0);
     setup();
 
-    rs_restore_file(inf);
+    if (rs_restore_file(inf) != 0)
+    {
+	endwin();
+	printf("\n%s\n", msg_get("MSG_SAVE_CANNOT_READ"));
+	return FALSE;
+    }
     /*
      * we do not close the file so that we will have a hold of the
      * inode for as long as possible
@@ -271,6 +289,7 @@ restore(char *file, char **envp)
     clearok(curscr, TRUE);
     srand(md_getpid());
     msg(msg_get("MSG_SAVE_FILE_NAME_RESULT"), file);
+    restored = TRUE;
     playit();
     /*NOTREACHED*/
     return(0);
@@ -225,7 +225,7 @@ def:
 			if ((obj = pp->p_monst) != NULL)
 			    obj->t_oldch = ch;
 			if (obj == NULL || !on(player, SEEMONST))
-			    mvaddch(y, x, ch);
+			    mvshow(y, x, ch);
 		    }
 		}
 	when S_FDET:
@@ -0,0 +1,600 @@
+/*
+ * Playing many games in one process, over local sockets
+ *
+ * "rogue -S path [workers]" listens on a unix socket at path and forks
+ * a worker for each processor (or as many as asked for).  Each worker
+ * takes connections as they come and keeps every game it has going in
+ * the one process: a curses screen that writes to the socket, a stack
+ * of its own to run on, and a blob holding its globals (see game.c).
+ * An epoll loop hands typed keys to whichever game they are for and
+ * runs it until it wants another key that has not come yet; then the
+ * worker goes on to the next one.  The globals only get copied when
+ * a different game than the last one runs.  Curses writes each game's
+ * screen into a pipe, which is emptied into a buffer of the game's own
+ * and sent as the socket takes it, so one player who stops reading
+ * holds up nobody else.
+ *
+ * Rogue: Exploring the Dungeons of Doom
+ * Copyright (C) 1980-1983, 1985, 1999 Michael Toy, Ken Arnold and Glenn Wichman
+ * All rights reserved.
+ *
+ * See the file LICENSE.TXT for full copyright and licensing information.
+ */
+
+#define _GNU_SOURCE			/* For F_SETPIPE_SZ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <curses.h>
+#include "rogue.h"
+#include "extern.h"
+#include "i18n.h"
+
+#ifdef __linux__
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <ucontext.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+
+#define SV_STACK	(512 * 1024)	/* Stack each game runs on */
+#define SV_KEYS		256		/* Keys typed ahead for a game */
+#define SV_EVENTS	64		/* Events taken from epoll at once */
+#define SV_TERM		"vt100"		/* Terminal when TERM is not set */
+#define SV_OUTMAX	(1024 * 1024)	/* Output held for a player at most */
+
+typedef struct session {
+    int s_fd;				/* Socket to the player */
+    FILE *s_out;			/* Where its screen goes */
+    int s_pipe;				/* Where it comes back out */
+    char *s_obuf;			/* Output not yet sent */
+    size_t s_olen, s_osize;		/* How much, and room for how much */
+    uint32_t s_events;			/* What epoll is watching for */
+    SCREEN *s_screen;			/* Its curses screen */
+    ucontext_t s_ctx;			/* Where it stopped for a key */
+    char *s_stack;			/* What it runs on */
+    char *s_game;			/* Its globals, while another runs */
+    char s_keys[SV_KEYS];		/* Keys typed and not yet read */
+    int s_nkeys, s_key;			/* How many, and the next one */
+    bool s_gone;			/* The player hung up */
+    bool s_over;			/* The game has ended */
+} SESSION;
+
+static ucontext_t sched_ctx;		/* The loop, while a game runs */
+static SESSION *cur_sess = NULL;	/* The game running now */
+static SESSION *loaded = NULL;		/* Whose globals are in place */
+static char *fresh_game;		/* Globals before any game starts */
+static FILE *null_in;			/* Curses' keyboard, never read */
+static int nsessions = 0;		/* Games this worker has started */
+static int epfd;			/* This worker's epoll */
+
+/*
+ * session_main:
+ *	Start a game off on its own stack; it comes back here only
+ *	through session_end()
+ */
+
+static void
+session_main()
+{
+    dnum = (int) time(NULL) + md_getpid() + nsessions;
+    rng_seed(fast_rng ? RNG_FAST : RNG_LEGACY, dnum);
+    init_game();
+    start_game();
+    my_exit(0);
+}
+
+/*
+ * run_session:
+ *	Let a game run until it needs a key it does not have
+ */
+
+static void
+run_session(SESSION *sp)
+{
+    set_term(sp->s_screen);
+    if (loaded != sp)
+    {
+	if (loaded != NULL)
+	    game_save(loaded->s_game);
+	game_load(sp->s_game);
+	loaded = sp;
+    }
+    cur_sess = sp;
+    swapcontext(&sched_ctx, &sp->s_ctx);
+    cur_sess = NULL;
+}
+
+/*
+ * take_out:
+ *	Empty what curses has written for a game into its buffer.  A
+ *	player who lets too much pile up is hung up on.
+ */
+
+static void
+take_out(SESSION *sp)
+{
+    char junk[BUFSIZ];
+    size_t nsize;
+    ssize_t n;
+    char *nbuf;
+
+    for (;;)
+    {
+	if (!sp->s_gone && sp->s_osize - sp->s_olen < BUFSIZ)
+	{
+	    nsize = sp->s_osize ? sp->s_osize * 2 : 4 * BUFSIZ;
+	    if (nsize > SV_OUTMAX || (nbuf = realloc(sp->s_obuf, nsize)) == NULL)
+	    {
+		sp->s_gone = TRUE;
+		sp->s_olen = 0;
+	    }
+	    else
+	    {
+		sp->s_obuf = nbuf;
+		sp->s_osize = nsize;
+	    }
+	}
+	if (sp->s_gone)
+	    n = read(sp->s_pipe, junk, sizeof junk);
+	else if ((n = read(sp->s_pipe, &sp->s_obuf[sp->s_olen],
+	    sp->s_osize - sp->s_olen)) > 0)
+		sp->s_olen += n;
+	if (n < 0 && errno == EINTR)
+	    continue;
+	if (n <= 0)
+	    return;
+    }
+}
+
+/*
+ * send_out:
+ *	Send as much of a game's output as the socket will take now
+ */
+
+static void
+send_out(SESSION *sp)
+{
+    ssize_t n;
+
+    if (sp->s_pipe >= 0)
+	take_out(sp);
+
+    while (sp->s_olen > 0)
+    {
+	n = send(sp->s_fd, sp->s_obuf, sp->s_olen, MSG_DONTWAIT|MSG_NOSIGNAL);
+	if (n < 0)
+	{
+	    if (errno == EINTR)
+		continue;
+	    if (errno != EAGAIN && errno != EWOULDBLOCK)
+	    {
+		sp->s_gone = TRUE;
+		sp->s_olen = 0;
+	    }
+	    return;
+	}
+	memmove(sp->s_obuf, &sp->s_obuf[n], sp->s_olen - n);
+	sp->s_olen -= n;
+    }
+}
+
+/*
+ * end_session:
+ *	Throw away a game that has ended.  The player is hung up on
+ *	once the last of its output has gone.
+ */
+
+static void
+end_session(SESSION *sp)
+{
+    THING *tp;
+    int i;
+
+    /*
+     * Its globals are the ones in place, since it was the last to run
+     */
+    for (tp = mlist; tp != NULL; tp = next(tp))
+	free_list(tp->t_pack);
+    free_list(mlist);
+    free_list(lvl_obj);
+    free_list(pack);
+    for (i = 0; i < MAXSCROLLS; i++)
+	free(s_names[i]);
+    loaded = NULL;
+
+    if (!isendwin())
+	endwin();
+    delwin(hw);
+    delscreen(sp->s_screen);
+    sp->s_screen = NULL;
+    fclose(sp->s_out);
+    send_out(sp);
+    close(sp->s_pipe);
+    sp->s_pipe = -1;
+    free(sp->s_stack);
+    free(sp->s_game);
+    sp->s_stack = sp->s_game = NULL;
+}
+
+/*
+ * hang_up:
+ *	Let go of a player whose game is over and whose output is sent
+ */
+
+static void
+hang_up(SESSION *sp)
+{
+    epoll_ctl(epfd, EPOLL_CTL_DEL, sp->s_fd, NULL);
+    close(sp->s_fd);
+    free(sp->s_obuf);
+    free(sp);
+}
+
+/*
+ * settle:
+ *	After a game has run or had output sent, finish it if it is
+ *	over, and have epoll watch for what it waits on now
+ */
+
+static void
+settle(SESSION *sp)
+{
+    struct epoll_event ev;
+    uint32_t want;
+
+    if (sp->s_over && sp->s_screen != NULL)
+	end_session(sp);
+    if (sp->s_screen == NULL && (sp->s_olen == 0 || sp->s_gone))
+    {
+	hang_up(sp);
+	return;
+    }
+    want = sp->s_screen != NULL ? EPOLLIN : 0;
+    if (sp->s_olen > 0)
+	want |= EPOLLOUT;
+    if (want != sp->s_events)
+    {
+	ev.events = want;
+	ev.data.ptr = sp;
+	epoll_ctl(epfd, EPOLL_CTL_MOD, sp->s_fd, &ev);
+	sp->s_events = want;
+    }
+}
+
+/*
+ * start_context:
+ *	Set a game up to start on its own stack the first time it runs
+ */
+
+static void
+start_context(SESSION *sp)
+{
+    getcontext(&sp->s_ctx);
+    sp->s_ctx.uc_stack.ss_sp = sp->s_stack;
+    sp->s_ctx.uc_stack.ss_size = SV_STACK;
+    sp->s_ctx.uc_link = &sched_ctx;
+    makecontext(&sp->s_ctx, session_main, 0);
+}
+
+/*
+ * new_session:
+ *	Start a game for a player who has just connected
+ */
+
+static SESSION *
+new_session(int fd)
+{
+    SESSION *sp;
+    char *term;
+    int pfd[2];
+
+    if ((sp = calloc(1, sizeof *sp)) == NULL)
+    {
+	close(fd);
+	return NULL;
+    }
+    sp->s_fd = fd;
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    if (pipe(pfd) < 0)
+	pfd[0] = pfd[1] = -1;
+    else
+    {
+	fcntl(pfd[0], F_SETFL, O_NONBLOCK);
+#ifdef F_SETPIPE_SZ
+	fcntl(pfd[1], F_SETPIPE_SZ, SV_OUTMAX);	/* Never full between reads */
+#endif
+    }
+    sp->s_pipe = pfd[0];
+    sp->s_stack = malloc(SV_STACK);
+    sp->s_game = malloc(game_size());
+    if ((term = getenv("TERM")) == NULL)
+	term = SV_TERM;
+    if (pfd[0] < 0 || sp->s_stack == NULL || sp->s_game == NULL
+	|| (sp->s_out = fdopen(pfd[1], "w")) == NULL
+	|| (sp->s_screen = newterm(term, sp->s_out, null_in)) == NULL)
+    {
+	if (sp->s_out != NULL)
+	    fclose(sp->s_out);
+	else if (pfd[1] >= 0)
+	    close(pfd[1]);
+	if (pfd[0] >= 0)
+	    close(pfd[0]);
+	close(fd);
+	free(sp->s_stack);
+	free(sp->s_game);
+	free(sp);
+	return NULL;
+    }
+    typeahead(-1);			/* Nothing to look at for keys */
+    memcpy(sp->s_game, fresh_game, game_size());
+    start_context(sp);
+    nsessions++;
+    return sp;
+}
+
+/*
+ * take_keys:
+ *	Read what the player has typed.  What will not fit is dropped,
+ *	like typing too far ahead of a real terminal.
+ */
+
+static void
+take_keys(SESSION *sp)
+{
+    char buf[SV_KEYS];
+    ssize_t n;
+    int room;
+
+    if (sp->s_key > 0)
+    {
+	memmove(sp->s_keys, &sp->s_keys[sp->s_key], sp->s_nkeys - sp->s_key);
+	sp->s_nkeys -= sp->s_key;
+	sp->s_key = 0;
+    }
+    n = recv(sp->s_fd, buf, sizeof buf, MSG_DONTWAIT);
+    if (n == 0 || (n < 0 && errno != EAGAIN && errno != EINTR))
+    {
+	sp->s_gone = TRUE;
+	return;
+    }
+    if (n < 0)
+	return;
+    room = SV_KEYS - sp->s_nkeys;
+    if (n > room)
+	n = room;
+    memcpy(&sp->s_keys[sp->s_nkeys], buf, n);
+    sp->s_nkeys += (int) n;
+}
+
+/*
+ * session_key:
+ *	The next key for the game running now.  Until the player has
+ *	typed one, other games run.  A sequence sent in pieces is not
+ *	waited for, since by the time one piece is read the rest has
+ *	almost always come with it.
+ */
+
+char
+session_key()
+{
+    SESSION *sp = cur_sess;
+    int key, used;
+
+    refresh();
+    fflush(sp->s_out);
+    send_out(sp);
+    while (sp->s_key == sp->s_nkeys)
+    {
+	if (sp->s_gone)
+	    my_exit(0);
+	swapcontext(&sp->s_ctx, &sched_ctx);
+    }
+    key = md_keydecode((unsigned char *) &sp->s_keys[sp->s_key],
+	sp->s_nkeys - sp->s_key, &used, FALSE);
+    sp->s_key += used;
+    return (char) (key & 0x7F);
+}
+
+/*
+ * session_flush:
+ *	Forget the keys typed ahead, as flushinp() would
+ */
+
+void
+session_flush()
+{
+    cur_sess->s_key = cur_sess->s_nkeys;
+}
+
+/*
+ * session_end:
+ *	The game running now is over; go back to the loop for good
+ */
+
+void
+session_end()
+{
+    SESSION *sp = cur_sess;
+
+    if (!isendwin())
+    {
+	refresh();
+	endwin();
+    }
+    fflush(sp->s_out);
+    send_out(sp);
+    sp->s_over = TRUE;
+    setcontext(&sched_ctx);
+}
+
+/*
+ * worker:
+ *	Take players from the socket and run their games, forever
+ */
+
+static void
+worker(int lfd)
+{
+    struct epoll_event ev, evs[SV_EVENTS];
+    SESSION *sp;
+    int fd, n, i;
+
+    if ((epfd = epoll_create1(0)) < 0)
+    {
+	perror("epoll_create1");
+	exit(1);
+    }
+    ev.events = EPOLLIN;
+#ifdef EPOLLEXCLUSIVE
+    ev.events |= EPOLLEXCLUSIVE;	/* Wake one worker, not all */
+#endif
+    ev.data.ptr = NULL;
+    epoll_ctl(epfd, EPOLL_CTL_ADD, lfd, &ev);
+    for (;;)
+    {
+	if ((n = epoll_wait(epfd, evs, SV_EVENTS, -1)) < 0)
+	{
+	    if (errno == EINTR)
+		continue;
+	    perror("epoll_wait");
+	    exit(1);
+	}
+	for (i = 0; i < n; i++)
+	{
+	    if ((sp = evs[i].data.ptr) == NULL)
+	    {
+		while ((fd = accept(lfd, NULL, NULL)) >= 0)
+		{
+		    if ((sp = new_session(fd)) == NULL)
+			continue;
+		    ev.events = sp->s_events = EPOLLIN;
+		    ev.data.ptr = sp;
+		    epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev);
+		    run_session(sp);
+		    settle(sp);
+		}
+		continue;
+	    }
+	    if (evs[i].events & EPOLLOUT)
+		send_out(sp);
+	    if (sp->s_screen != NULL && (evs[i].events & ~EPOLLOUT))
+	    {
+		take_keys(sp);
+		if (sp->s_key < sp->s_nkeys || sp->s_gone)
+		    run_session(sp);
+	    }
+	    else if (evs[i].events & (EPOLLHUP|EPOLLERR))
+		sp->s_gone = TRUE;
+	    settle(sp);
+	}
+    }
+}
+
+/*
+ * serve:
+ *	Listen at path and start the workers
+ */
+
+void
+serve(char *path, int workers)
+{
+    static char lines[20], cols[20];
+    struct sockaddr_un sun;
+    int lfd, i;
+
+    if (workers <= 0 && (workers = (int) sysconf(_SC_NPROCESSORS_ONLN)) <= 0)
+	workers = 1;
+    if (strlen(path) >= sizeof sun.sun_path)
+    {
+	fprintf(stderr, "%s: %s\n", path, strerror(ENAMETOOLONG));
+	exit(1);
+    }
+    memset(&sun, 0, sizeof sun);
+    sun.sun_family = AF_UNIX;
+    strcpy(sun.sun_path, path);
+    unlink(path);
+    if ((lfd = socket(AF_UNIX, SOCK_STREAM, 0)) < 0
+	|| bind(lfd, (struct sockaddr *) &sun, sizeof sun) < 0
+	|| listen(lfd, SOMAXCONN) < 0)
+    {
+	perror(path);
+	exit(1);
+    }
+    fcntl(lfd, F_SETFL, fcntl(lfd, F_GETFL) | O_NONBLOCK);
+    signal(SIGPIPE, SIG_IGN);
+
+    /*
+     * Every game gets a screen just the size of the map, and the
+     * same tables to start from
+     */
+    sprintf(lines, "LINES=%d", NUMLINES);
+    sprintf(cols, "COLUMNS=%d", NUMCOLS);
+    putenv(lines);
+    putenv(cols);
+    if ((null_in = fopen("/dev/null", "r")) == NULL)
+    {
+	perror("/dev/null");
+	exit(1);
+    }
+    serving = TRUE;
+    init_tables();
+    fresh_game = malloc(game_size());
+    game_save(fresh_game);
+
+    printf(msg_get("MSG_SERVER_LISTENING"), path, workers);
+    printf("\n");
+    fflush(stdout);
+    for (i = 0; i < workers; i++)
+	switch (fork())
+	{
+	    case -1:
+		perror("fork");
+		break;
+	    case 0:
+		worker(lfd);
+		exit(0);
+	}
+    while (wait(NULL) > 0)
+	continue;
+    unlink(path);
+}
+
+#else
+
+/*
+ * Games are only served where there is epoll and ucontext
+ */
+
+char
+session_key()
+{
+    return ESCAPE;
+}
+
+void
+session_flush()
+{
+}
+
+void
+session_end()
+{
+    exit(0);
+}
+
+void
+serve(char *path, int workers)
+{
+    NOOP(workers);
+    printf(msg_get("MSG_SERVER_UNSUPPORTED"), path);
+    printf("\n");
+}
+
+#endif
@@ -62,6 +62,8 @@
 #define RSID_CTYPES       0XABCD0015
 #define RSID_COORDLIST    0XABCD0016
 #define RSID_ROOMS        0XABCD0017
+#define RSID_LEVEL        0XABCD0018
+#define RSID_RNG          0XABCD0019
 
 #define READSTAT (format_error || read_error )
 #define WRITESTAT (write_error)
@@ -715,6 +717,46 @@ rs_read_coord(FILE *inf, coord *c)
     return(READSTAT);
 }
 
+int
+rs_write_rng(FILE *savef, RNG *rp)
+{
+    if (write_error)
+        return(WRITESTAT);
+
+    rs_write_marker(savef, RSID_RNG);
+    rs_write_int(savef, rp->r_kind);
+    rs_write_int(savef, rp->r_seed);
+    rs_write_uint(savef, (unsigned int) (rp->r_key >> 32));
+    rs_write_uint(savef, (unsigned int) rp->r_key);
+    rs_write_uint(savef, (unsigned int) (rp->r_state >> 32));
+    rs_write_uint(savef, (unsigned int) rp->r_state);
+
+    return(WRITESTAT);
+}
+
+int
+rs_read_rng(FILE *inf, RNG *rp)
+{
+    unsigned int hi, lo;
+
+    if (read_error || format_error)
+        return(READSTAT);
+
+    rs_read_marker(inf, RSID_RNG);
+    rs_read_int(inf, &rp->r_kind);
+    if (rp->r_kind != RNG_LEGACY && rp->r_kind != RNG_FAST)
+        format_error = 1;
+    rs_read_int(inf, &rp->r_seed);
+    rs_read_uint(inf, &hi);
+    rs_read_uint(inf, &lo);
+    rp->r_key = ((uint64_t) hi << 32) | lo;
+    rs_read_uint(inf, &hi);
+    rs_read_uint(inf, &lo);
+    rp->r_state = ((uint64_t) hi << 32) | lo;
+
+    return(READSTAT);
+}
+
 int
 rs_write_window(FILE *savef, WINDOW *win)
 {
@@ -1853,7 +1895,17 @@ rs_write_places(FILE *savef, PLACE *places, int count)
     for(i = 0; i < count; i++) 
     {
         rs_write_char(savef, places[i].p_ch);
-        rs_write_char(savef, places[i].p_flags);
+        /*
+         * Passage numbers go in the flags, as they always have, unless
+         * the map is too big for them to fit
+         */
+        if (MAXPASS <= F_PNUM + 1)
+            rs_write_char(savef, places[i].p_flags | places[i].p_pnum);
+        else
+        {
+            rs_write_char(savef, places[i].p_flags);
+            rs_write_int(savef, places[i].p_pnum);
+        }
         rs_write_thing_reference(savef, mlist, places[i].p_monst);
     }
 
@@ -1863,7 +1915,8 @@ rs_write_places(FILE *savef, PLACE *places, int count)
 int 
 rs_read_places(FILE *inf, PLACE *places, int count)
 {
-    int i = 0;
+    int i = 0, pnum;
+    char ch;
     
     if (read_error || format_error)
         return(READSTAT);
@@ -1872,6 +1925,25 @@ rs_read_places(FILE *inf, PLACE *places, int count)
     {
         rs_read_char(inf,&places[i].p_ch);
         rs_read_char(inf,&places[i].p_flags);
+        if (MAXPASS <= F_PNUM + 1)
+        {
+            /*
+             * The low bits of the flags are the passage number on
+             * passages and doors, and the trap type elsewhere
+             */
+            ch = places[i].p_ch;
+            if ((places[i].p_flags & F_PASS) || ch == DOOR ||
+                (!(places[i].p_flags & F_REAL) && (ch == '|' || ch == '-')))
+            {
+                pnum = places[i].p_flags & F_PNUM;
+                places[i].p_flags &= ~F_PNUM;
+            }
+            else
+                pnum = 0;
+        }
+        else
+            rs_read_int(inf, &pnum);
+        places[i].p_pnum = (unsigned char) pnum;
         rs_read_thing_reference(inf, mlist, &places[i].p_monst);
     }
 
@@ -1881,6 +1953,8 @@ rs_read_places(FILE *inf, PLACE *places, int count)
 int
 rs_save_file(FILE *savef)
 {
+    int i;
+
     if (write_error)
         return(WRITESTAT);
 
@@ -1957,7 +2031,9 @@ rs_save_file(FILE *savef)
     rs_write_int(savef, quiet);
     rs_write_int(savef, vf_hit);
     rs_write_int(savef, dnum);
-    rs_write_int(savef, seed);
+    rs_write_int(savef, NSTREAMS);
+    for (i = 0; i < NSTREAMS; i++)
+        rs_write_rng(savef, &streams[i]);
     rs_write_ints(savef, e_levels, 21);
     rs_write_coord(savef, delta);
     rs_write_coord(savef, oldpos);
@@ -1974,6 +2050,8 @@ rs_save_file(FILE *savef)
     rs_write_object_list(savef, lvl_obj);               
     rs_write_thing_list(savef, mlist);                
 
+    rs_write_int(savef, NUMLINES);                  /* how big a map */
+    rs_write_int(savef, NUMCOLS);
     rs_write_places(savef,places,MAXLINES*MAXCOLS);
 
     rs_write_stats(savef,&max_stats); 
@@ -2009,7 +2087,7 @@ rs_save_file(FILE *savef)
 int
 rs_restore_file(FILE *inf)
 {
-    int dummyint;
+    int dummyint, i;
 
     if (read_error || format_error)
         return(READSTAT);
@@ -2087,7 +2165,12 @@ rs_restore_file(FILE *inf)
     rs_read_int(inf, &quiet);
     rs_read_int(inf, &vf_hit);
     rs_read_int(inf, &dnum);
-    rs_read_int(inf, &seed);
+    rs_read_int(inf, &i);
+    if (i != NSTREAMS)
+        format_error = 1;
+    for (i = 0; i < NSTREAMS; i++)
+        rs_read_rng(inf, &streams[i]);
+    rng = &streams[RS_MAIN];
     rs_read_ints(inf,e_levels,21);
     rs_read_coord(inf, &delta);
     rs_read_coord(inf, &oldpos);
@@ -2106,12 +2189,18 @@ rs_restore_file(FILE *inf)
     rs_fix_thing(&player);
     rs_fix_thing_list(mlist);
 
+    rs_read_int(inf, &i);                       /* built for this map? */
+    rs_read_int(inf, &dummyint);
+    if (i != NUMLINES || dummyint != NUMCOLS)
+        format_error = 1;
     rs_read_places(inf,places,MAXLINES*MAXCOLS);
+    index_objs();
 
     rs_read_stats(inf, &max_stats);
     rs_read_rooms(inf, rooms, MAXROOMS);
     rs_read_room_reference(inf, &oldrp);
     rs_read_rooms(inf, passages, MAXPASS);
+    index_rooms();
 
     rs_read_monsters(inf,monsters,26);                  
     rs_read_obj_info(inf, things,   NUMTHINGS);         
@@ -2129,6 +2218,78 @@ rs_restore_file(FILE *inf)
     rs_read_int(inf,&group);                            /* 5.4-weapons.c    */
     
     rs_read_window(inf,stdscr);
+    sync_map();
+
+    return(READSTAT);
+}
+
+/*
+ * The level cache keeps levels on disk in the same form as a saved
+ * game keeps the current one: first what the level was dug from,
+ * then the level itself.  These start over with no errors, since
+ * they are not part of writing or reading a whole game.
+ */
+
+int
+rs_write_level(FILE *savef, LEVKEY *kp, int first)
+{
+    write_error = FALSE;
+
+    rs_write_marker(savef, RSID_LEVEL);
+    rs_write_rng(savef, &kp->k_rng);
+    rs_write_int(savef, kp->k_level);
+    rs_write_int(savef, kp->k_food);
+    rs_write_int(savef, kp->k_flags);
+
+    rs_write_object_list(savef, lvl_obj);
+    rs_write_thing_list(savef, mlist);
+    rs_write_places(savef, places, MAXLINES*MAXCOLS);
+    rs_write_rooms(savef, rooms, MAXROOMS);
+    rs_write_rooms(savef, passages, MAXPASS);
+    rs_write_coord(savef, stairs);
+    rs_write_int(savef, ntraps);
+    rs_write_int(savef, no_food);
+    rs_write_int(savef, first);
+    rs_write_int(savef, group);
+    rs_write_rng(savef, rng);
+
+    return(WRITESTAT);
+}
+
+int
+rs_read_level(FILE *inf, LEVKEY *kp, int *first, int *last)
+{
+    LEVKEY key;
+    RNG after;
+
+    read_error = FALSE;
+    format_error = FALSE;
+
+    rs_read_marker(inf, RSID_LEVEL);
+    rs_read_rng(inf, &key.k_rng);
+    rs_read_int(inf, &key.k_level);
+    rs_read_int(inf, &key.k_food);
+    rs_read_int(inf, &key.k_flags);
+    if (READSTAT || !same_key(&key, kp))
+    {
+        format_error = TRUE;
+        return(READSTAT);
+    }
+
+    rs_read_object_list(inf, &lvl_obj);
+    rs_read_thing_list(inf, &mlist);
+    rs_fix_thing_list(mlist);
+    rs_read_places(inf, places, MAXLINES*MAXCOLS);
+    rs_read_rooms(inf, rooms, MAXROOMS);
+    rs_read_rooms(inf, passages, MAXPASS);
+    rs_read_coord(inf, &stairs);
+    rs_read_int(inf, &ntraps);
+    rs_read_int(inf, &no_food);
+    rs_read_int(inf, first);
+    rs_read_int(inf, last);
+    rs_read_rng(inf, &after);
+    if (!READSTAT)
+        *rng = after;
 
     return(READSTAT);
 }
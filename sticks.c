@@ -40,6 +40,20 @@ fix_stick(THING *cur)
     }
 }
 
+/*
+ * What a zap is in the middle of, kept for the game it belongs to
+ * while it waits on a --More--
+ */
+static THING zap_bolt;			/* Magic missile on its way */
+static THING *drainee[40];		/* Who drain life is spread among */
+static coord bolt_pos;			/* Where a bolt has got to */
+static coord bolt_spots[BOLT_LENGTH];	/* And where it has been */
+
+GAMEVAR sticks_vars[] = {
+    GV(zap_bolt), GV(drainee), GV(bolt_pos), GV(bolt_spots),
+    GV_END
+};
+
 /*
  * do_zap:
  *	Perform a zap with a wand
@@ -52,7 +66,6 @@ do_zap()
     int y, x;
     char *name;
     char monster, oldch;
-    static THING bolt;
 
     if ((obj = get_item(msg_get("MSG_PURPOSE_ZAP_WITH"), STICK)) == NULL)
 	return;
@@ -122,7 +135,7 @@ do_zap()
 		    case WS_INVIS:
 			tp->t_flags |= ISINVIS;
 			if (cansee(y, x))
-			    mvaddch(y, x, tp->t_oldch);
+			    mvshow(y, x, tp->t_oldch);
 			break;
 		    case WS_POLYMORPH:
 		    {
@@ -130,14 +143,15 @@ do_zap()
 
 			pp = tp->t_pack;
 			detach(mlist, tp);
+			room_detach(tp);
 			if (see_monst(tp))
-			    mvaddch(y, x, chat(y, x));
+			    mvshow(y, x, chat(y, x));
 			oldch = tp->t_oldch;
 			delta.y = y;
 			delta.x = x;
 			new_monster(tp, monster = (char)(rnd(26) + 'A'), &delta);
 			if (see_monst(tp))
-			    mvaddch(y, x, monster);
+			    mvshow(y, x, monster);
 			tp->t_oldch = oldch;
 			tp->t_pack = pp;
 			ws_info[WS_POLYMORPH].oi_know |= see_monst(tp);
@@ -148,7 +162,7 @@ do_zap()
 			tp->t_flags &= ~(ISINVIS|CANHUH);
 			tp->t_disguise = tp->t_type;
 			if (see_monst(tp))
-			    mvaddch(y, x, tp->t_disguise);
+			    mvshow(y, x, tp->t_disguise);
 			break;
 		    case WS_TELAWAY:
 		    case WS_TELTO:
@@ -159,7 +173,11 @@ do_zap()
 			{
 			    do
 			    {
-				find_floor(NULL, &new_pos, FALSE, TRUE);
+				if (!find_floor(NULL, &new_pos, FALSE, TRUE))
+				{
+				    new_pos = tp->t_pos;	/* Nowhere to go */
+				    break;
+				}
 			    } while (ce(new_pos, hero));
 			}
 			else
@@ -167,7 +185,7 @@ do_zap()
 			    new_pos.y = hero.y + delta.y;
 			    new_pos.x = hero.x + delta.x;
 			}
-			tp->t_dest = &hero;
+			set_dest(tp, &hero);
 			tp->t_flags |= ISRUN;
 			relocate(tp, &new_pos);
 		    }
@@ -175,17 +193,17 @@ do_zap()
 	    }
 	when WS_MISSILE:
 	    ws_info[WS_MISSILE].oi_know = TRUE;
-	    bolt.o_type = '*';
-	    strncpy(bolt.o_hurldmg,"1x4",sizeof(bolt.o_hurldmg));
-	    bolt.o_hplus = 100;
-	    bolt.o_dplus = 1;
-	    bolt.o_flags = ISMISL;
+	    zap_bolt.o_type = '*';
+	    strncpy(zap_bolt.o_hurldmg,"1x4",sizeof(zap_bolt.o_hurldmg));
+	    zap_bolt.o_hplus = 100;
+	    zap_bolt.o_dplus = 1;
+	    zap_bolt.o_flags = ISMISL;
 	    if (cur_weapon != NULL)
-		bolt.o_launch = cur_weapon->o_which;
-	    do_motion(&bolt, delta.y, delta.x);
-	    if ((tp = moat(bolt.o_pos.y, bolt.o_pos.x)) != NULL
+		zap_bolt.o_launch = cur_weapon->o_which;
+	    do_motion(&zap_bolt, delta.y, delta.x);
+	    if ((tp = moat(zap_bolt.o_pos.y, zap_bolt.o_pos.x)) != NULL
 		&& !save_throw(VS_MAGIC, tp))
-		    hit_monster(unc(bolt.o_pos), &bolt);
+		    hit_monster(unc(zap_bolt.o_pos), &zap_bolt);
 	    else if (terse)
 		msg(msg_get("MSG_STICK_MISSILE_VANISHES"));
 	    else
@@ -250,33 +268,53 @@ void
 drain()
 {
     THING *mp;
-    struct room *corp;
-    THING **dp;
+    struct room *corp, *rp;
+    THING **dp, **sp;
     int cnt;
     bool inpass;
-    static THING *drainee[40];
 
     /*
      * First cnt how many things we need to spread the hit points among
      */
     cnt = 0;
     if (chat(hero.y, hero.x) == DOOR)
-	corp = &passages[flat(hero.y, hero.x) & F_PNUM];
+	corp = &passages[pnat(hero.y, hero.x)];
     else
 	corp = NULL;
     inpass = (bool)(proom->r_flags & ISGONE);
     dp = drainee;
-    for (mp = mlist; mp != NULL; mp = next(mp))
-	if (mp->t_room == proom || mp->t_room == corp ||
-	    (inpass && chat(mp->t_pos.y, mp->t_pos.x) == DOOR &&
-	    &passages[flat(mp->t_pos.y, mp->t_pos.x) & F_PNUM] == proom))
-		*dp++ = mp;
+    for (mp = proom->r_monst; mp != NULL; mp = mp->t_rnext)
+	*dp++ = mp;
+    if (corp != NULL)
+	for (mp = corp->r_monst; mp != NULL; mp = mp->t_rnext)
+	    *dp++ = mp;
+    /*
+     * Monsters standing in the doorways of a passage belong to
+     * the rooms, so look for them there
+     */
+    if (inpass)
+	for (rp = rooms; rp < &rooms[MAXROOMS]; rp++)
+	    for (mp = rp->r_monst; mp != NULL; mp = mp->t_rnext)
+		if (chat(mp->t_pos.y, mp->t_pos.x) == DOOR &&
+		    &passages[pnat(mp->t_pos.y, mp->t_pos.x)] == proom)
+			*dp++ = mp;
     if ((cnt = (int)(dp - drainee)) == 0)
     {
 	msg(msg_get("MSG_STICK_TINGLING"));
 	return;
     }
     *dp = NULL;
+    /*
+     * Each list is in mlist order, but they have to be merged so that
+     * the monsters are zotted in that order too
+     */
+    for (dp = &drainee[1]; *dp != NULL; dp++)
+	for (sp = dp; sp > drainee && sp[-1]->t_seq < sp[0]->t_seq; sp--)
+	{
+	    mp = sp[0];
+	    sp[0] = sp[-1];
+	    sp[-1] = mp;
+	}
     pstats.s_hpt /= 2;
     cnt = pstats.s_hpt / cnt;
     /*
@@ -304,8 +342,6 @@ fire_bolt(coord *start, coord *dir, char *name)
     THING *tp;
     char dirch = 0, ch;
     bool hit_hero, used, changed;
-    static coord pos;
-    static coord spotpos[BOLT_LENGTH];
     THING bolt;
 
     bolt.o_type = WEAPON;
@@ -320,16 +356,16 @@ fire_bolt(coord *start, coord *dir, char *name)
 	when 1: case -1: dirch = (dir->y == 0 ? '-' : '|');
 	when 2: case -2: dirch = '\\';
     }
-    pos = *start;
+    bolt_pos = *start;
     hit_hero = (bool)(start != &hero);
     used = FALSE;
     changed = FALSE;
-    for (c1 = spotpos; c1 <= &spotpos[BOLT_LENGTH-1] && !used; c1++)
+    for (c1 = bolt_spots; c1 <= &bolt_spots[BOLT_LENGTH-1] && !used; c1++)
     {
-	pos.y += dir->y;
-	pos.x += dir->x;
-	*c1 = pos;
-	ch = winat(pos.y, pos.x);
+	bolt_pos.y += dir->y;
+	bolt_pos.x += dir->x;
+	*c1 = bolt_pos;
+	ch = winat(bolt_pos.y, bolt_pos.x);
 	switch (ch)
 	{
 	    case DOOR:
@@ -338,7 +374,7 @@ fire_bolt(coord *start, coord *dir, char *name)
 		 * and he fires at the wall the door is in, it would
 		 * otherwise loop infinitely
 		 */
-		if (ce(hero, pos))
+		if (ce(hero, bolt_pos))
 		    goto def;
 		/* FALLTHROUGH */
 	    case '|':
@@ -354,14 +390,14 @@ fire_bolt(coord *start, coord *dir, char *name)
 		break;
 	    default:
 def:
-		if (!hit_hero && (tp = moat(pos.y, pos.x)) != NULL)
+		if (!hit_hero && (tp = moat(bolt_pos.y, bolt_pos.x)) != NULL)
 		{
 		    hit_hero = TRUE;
 		    changed = !changed;
-		    tp->t_oldch = chat(pos.y, pos.x);
+		    tp->t_oldch = chat(bolt_pos.y, bolt_pos.x);
 		    if (!save_throw(VS_MAGIC, tp))
 		    {
-			bolt.o_pos = pos;
+			bolt.o_pos = bolt_pos;
 			used = TRUE;
 			if (tp->t_type == 'D' && strcmp(name, "flame") == 0)
 			{
@@ -371,19 +407,19 @@ def:
 			    endmsg();
 			}
 			else
-			    hit_monster(unc(pos), &bolt);
+			    hit_monster(unc(bolt_pos), &bolt);
 		    }
 		    else if (ch != 'M' || tp->t_disguise == 'M')
 		    {
 			if (start == &hero)
-			    runto(&pos);
+			    runto(&bolt_pos);
 			if (terse)
 			    msg(msg_get("MSG_STICK_MISSES"), name);
 			else
 			    msg(msg_get("MSG_STICK_WHIZZES_PAST"), name, set_mname(tp));
 		    }
 		}
-		else if (hit_hero && ce(pos, hero))
+		else if (hit_hero && ce(bolt_pos, hero))
 		{
 		    hit_hero = FALSE;
 		    changed = !changed;
@@ -405,12 +441,16 @@ def:
 		    else
 			msg(msg_get("MSG_STICK_WHIZZES_BY"), name);
 		}
-		mvaddch(pos.y, pos.x, dirch);
-		refresh();
+		if (animate)
+		{
+		    mvshow(bolt_pos.y, bolt_pos.x, dirch);
+		    show_frame();
+		}
 	}
     }
-    for (c2 = spotpos; c2 < c1; c2++)
-	mvaddch(c2->y, c2->x, chat(c2->y, c2->x));
+    if (animate)
+	for (c2 = bolt_spots; c2 < c1; c2++)
+	    mvshow(c2->y, c2->x, chat(c2->y, c2->x));
 }
 
 /*
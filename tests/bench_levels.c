@@ -0,0 +1,175 @@
+/*
+ * Level generation benchmark
+ *
+ * Digs levels over and over with dig_level(), going down through depths
+ * 1 to 26 and starting over, and reports how fast it went, how often
+ * find_floor() and rnd_room() had to try again, and whether everything
+ * on each level can be reached from the stairs.  Only the digging is
+ * timed, not the checking.
+ *
+ *     tests/bench_levels [levels [seed [legacy]]]
+ *
+ * Nothing is drawn; levels are only dug into places[].
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <curses.h>
+#include "rogue.h"
+#include "extern.h"
+
+#define BENCH_DEPTH 26
+
+/* Empty the map and lists, as new_level() does before digging */
+static void empty_level(void) {
+    THING *tp;
+
+    for (int i = 0; i < MAXLINES * MAXCOLS; i++) {
+        places[i].p_ch = ' ';
+        places[i].p_flags = F_REAL;
+        places[i].p_pnum = 0;
+        places[i].p_monst = NULL;
+        places[i].p_obj = NULL;
+    }
+    for (tp = mlist; tp != NULL; tp = next(tp))
+        free_list(tp->t_pack);
+    free_list(mlist);
+    free_list(lvl_obj);
+    index_rooms();
+}
+
+/* Can the hero stand on this spot, once secret doors and passages are found */
+static int open_spot(int y, int x) {
+    PLACE *pp;
+
+    if (y < 1 || y >= NUMLINES - 1 || x < 0 || x >= NUMCOLS)
+        return 0;
+    pp = INDEX(y, x);
+    if (pp->p_ch == ' ')
+        return (pp->p_flags & F_PASS) != 0;
+    if (pp->p_ch == '|' || pp->p_ch == '-')
+        return !(pp->p_flags & F_REAL);
+    return 1;
+}
+
+/*
+ * Flood the level from the stairs.  Returns the number of open spots
+ * that could not be reached; zero means the level is connected.
+ */
+static int unreached(void) {
+    static coord queue[MAXLINES * MAXCOLS];
+    static char seen[MAXLINES * MAXCOLS];
+    static const int dy[4] = { -1, 1, 0, 0 }, dx[4] = { 0, 0, -1, 1 };
+    int head = 0, tail = 0, open = 0, y, x;
+
+    memset(seen, 0, sizeof seen);
+    queue[tail++] = stairs;
+    seen[INDEX(stairs.y, stairs.x) - places] = 1;
+    while (head < tail) {
+        coord c = queue[head++];
+
+        for (int d = 0; d < 4; d++) {
+            y = c.y + dy[d];
+            x = c.x + dx[d];
+            if (open_spot(y, x) && !seen[INDEX(y, x) - places]) {
+                seen[INDEX(y, x) - places] = 1;
+                queue[tail].y = y;
+                queue[tail].x = x;
+                tail++;
+            }
+        }
+    }
+    for (y = 1; y < NUMLINES - 1; y++)
+        for (x = 0; x < NUMCOLS; x++)
+            if (open_spot(y, x))
+                open++;
+    return open - tail;
+}
+
+static int list_length(THING *list) {
+    int n = 0;
+
+    for (; list != NULL; list = next(list))
+        n++;
+    return n;
+}
+
+int main(int argc, char **argv) {
+    long nlevels = 100000, broken = 0, lost = 0, nobj = 0, nmon = 0;
+    long tries[BENCH_DEPTH + 1], dug[BENCH_DEPTH + 1];
+    int seed = 1, kind = RNG_FAST, depth;
+    clock_t start, digging = 0;
+    long elapsed;
+
+    if (argc > 1)
+        nlevels = atol(argv[1]);
+    if (argc > 2)
+        seed = atoi(argv[2]);
+    if (argc > 3 && strcmp(argv[3], "legacy") == 0)
+        kind = RNG_LEGACY;
+
+    headless = TRUE;
+    rng_seed(kind, seed);
+    init_probs();
+    init_names();
+    init_rainbow();
+    init_colors();
+    init_stones_array();
+    init_stones();
+    init_wood_array();
+    init_metal_array();
+    init_materials();
+    init_monsters();
+    memset(tries, 0, sizeof tries);
+    memset(dug, 0, sizeof dug);
+
+    for (long n = 0; n < nlevels; n++) {
+        long before;
+        int left;
+
+        depth = (int) (n % BENCH_DEPTH) + 1;
+        if (depth == 1 && kind == RNG_FAST)
+            rng_seed(kind, seed + (int) (n / BENCH_DEPTH));
+        level = max_level = depth;
+        no_food = 0;
+        empty_level();
+        rng_level(level);
+        rng_use(RS_LEVEL);
+        before = floor_tries + room_tries;
+        start = clock();
+        dig_level();
+        digging += clock() - start;
+        rng_use(RS_MAIN);
+        tries[depth] += floor_tries + room_tries - before;
+        dug[depth]++;
+        nobj += list_length(lvl_obj);
+        nmon += list_length(mlist);
+        if ((left = unreached()) != 0) {
+            broken++;
+            lost += left;
+        }
+    }
+    elapsed = (long) (digging * 1000 / CLOCKS_PER_SEC);
+    empty_level();
+
+    printf("levels dug:        %ld (%s generator, seed %d)\n", nlevels,
+        kind == RNG_FAST ? "fast" : "legacy", seed);
+    printf("time digging:      %ld ms\n", elapsed);
+    if (elapsed > 0)
+        printf("levels/second:     %.0f\n", nlevels * 1000.0 / elapsed);
+    printf("find_floor tries:  %ld\n", floor_tries);
+    printf("rnd_room tries:    %ld\n", room_tries);
+    if (nlevels > 0) {
+        printf("things/level:      %.2f\n", (double) nobj / nlevels);
+        printf("monsters/level:    %.2f\n", (double) nmon / nlevels);
+        printf("not connected:     %ld (%.3f%%), %ld spots cut off\n", broken,
+            broken * 100.0 / nlevels, lost);
+    }
+    printf("tries per level by depth:\n");
+    for (depth = 1; depth <= BENCH_DEPTH; depth++)
+        if (dug[depth] > 0)
+            printf("  %2d: %.1f\n", depth, (double) tries[depth] / dug[depth]);
+    return 0;
+}
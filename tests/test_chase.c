@@ -33,6 +33,7 @@ static void clear_map(void) {
             pp->p_ch = ' ';
             pp->p_flags = 0;
             pp->p_monst = NULL;
+            pp->p_obj = NULL;
         }
     }
 }
@@ -61,6 +62,7 @@ static int setup_chase_tests(void **state) {
     rooms[0].r_flags = 0; // Default to not dark
 
     mlist = NULL;
+    lvl_obj = NULL;
     player.t_flags = 0;
     hero.y = 5;
     hero.x = 10;
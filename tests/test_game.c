@@ -0,0 +1,60 @@
+/*
+ * Tests for game.c
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdlib.h>
+#include <string.h>
+#include <cmocka.h>
+#include <curses.h>
+#include "rogue.h"
+
+/* Test: a game copied out comes back just as it was, over another one */
+static void test_game_save_load(void **state) {
+    (void) state;
+    char *one, *two;
+    int old_level = level, old_purse = purse;
+    PLACE old_place = places[0];
+
+    assert_true(game_size() >= MAXLINES * MAXCOLS * sizeof (PLACE) + sizeof player);
+    one = malloc(game_size());
+    two = malloc(game_size());
+    assert_non_null(one);
+    assert_non_null(two);
+
+    level = 5;
+    purse = 123;
+    places[0].p_ch = '%';
+    game_save(one);
+
+    level = 9;
+    purse = 7;
+    places[0].p_ch = '#';
+    game_save(two);
+
+    game_load(one);
+    assert_int_equal(5, level);
+    assert_int_equal(123, purse);
+    assert_int_equal('%', places[0].p_ch);
+
+    game_load(two);
+    assert_int_equal(9, level);
+    assert_int_equal(7, purse);
+    assert_int_equal('#', places[0].p_ch);
+
+    free(one);
+    free(two);
+    level = old_level;
+    purse = old_purse;
+    places[0] = old_place;
+}
+
+int run_game_tests(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_game_save_load),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -7,7 +7,10 @@
 #include <setjmp.h>
 #include <cmocka.h>
 #include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 #include <curses.h>
 #include "rogue.h"
 
@@ -70,11 +73,50 @@ static void test_sumprobs_accumulates(void **state) {
     assert_int_equal(100, info[2].oi_prob);
 }
 
+/* Test: "rogue -p file" starts from the recording, not ROGUEOPTS or the clock */
+static void test_init_seed_replay(void **state) {
+    (void) state;
+    char name[] = "/tmp/rogue_seedXXXXXX";
+    char *argv[] = { "rogue", "-p", name, NULL };
+    int fd, saved_dnum = dnum;
+    bool saved_fast = fast_rng;
+    char saved_who[MAXSTR];
+
+    fd = mkstemp(name);
+    assert_true(fd >= 0);
+    close(fd);
+    strcpy(saved_who, whoami);
+    strcpy(rec_file, name);
+    dnum = 4242;
+    fast_rng = FALSE;
+    strcpy(whoami, "tester");
+    start_record();
+    end_record();
+
+    setenv("ROGUEOPTS", "name=other", 1);
+    dnum = 0;
+    whoami[0] = '\0';
+    assert_int_equal(1, init_seed(3, argv));
+    assert_int_equal(4242, dnum);
+    assert_string_equal("tester", whoami);
+    assert_true(replaying);
+
+    replaying = FALSE;
+    headless = FALSE;
+    noscore = FALSE;
+    dnum = saved_dnum;
+    fast_rng = saved_fast;
+    strcpy(whoami, saved_who);
+    unsetenv("ROGUEOPTS");
+    unlink(name);
+}
+
 int run_init_tests(void) {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_pick_color_normal),
         cmocka_unit_test(test_pick_color_hallucinating),
         cmocka_unit_test(test_sumprobs_accumulates),
+        cmocka_unit_test(test_init_seed_replay),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
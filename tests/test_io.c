@@ -6,6 +6,8 @@
 #include <stddef.h>
 #include <setjmp.h>
 #include <cmocka.h>
+#include <stdio.h>
+#include <string.h>
 #include <curses.h>
 #include "rogue.h"
 
@@ -26,10 +28,223 @@ static void test_step_ok_allows_other_tiles(void **state) {
     assert_true(step_ok('*'));
 }
 
+/* Test: mvshow remembers what was drawn, standout bit and all */
+static void test_mvshow_remembers_map(void **state) {
+    (void) state;
+
+    mvshow(5, 10, FLOOR);
+    mvshow(6, 10, 'K' | A_STANDOUT);
+    assert_int_equal(shown(5, 10), FLOOR);
+    assert_int_equal(CCHAR(shown(6, 10)), 'K');
+    assert_true(shown(6, 10) & A_STANDOUT);
+    flush_map();
+    assert_int_equal(shown(5, 10), FLOOR);
+}
+
+/* Test: flush_map() sends curses just the spots that changed, and keeps the cursor */
+static void test_flush_map_draws_changes(void **state) {
+    (void) state;
+    FILE *out = fopen("/dev/null", "w");
+    FILE *in = fopen("/dev/null", "r");
+    SCREEN *scr;
+    int y, x;
+
+    assert_non_null(out);
+    assert_non_null(in);
+    scr = newterm("vt100", out, in);
+    assert_non_null(scr);
+    flush_map();			/* whatever earlier tests left */
+    for (x = 10; x <= 12; x++)
+        mvshow(5, x, FLOOR);
+    flush_map();
+    for (x = 10; x <= 12; x++) {
+        assert_int_equal(FLOOR, INDEX(5, x)->p_drawn);
+        assert_int_equal(FLOOR, mvinch(5, x) & A_CHARTEXT);
+    }
+
+    /*
+     * (5,11) is inside what changed, but is the same, so what curses
+     * has there is left alone
+     */
+    mvaddch(5, 11, 'Q');
+    mvshow(5, 10, 'K' | A_STANDOUT);
+    mvshow(5, 12, PASSAGE);
+    move(1, 2);
+    flush_map();
+    getyx(stdscr, y, x);
+    assert_int_equal(1, y);
+    assert_int_equal(2, x);
+    assert_int_equal('K' | A_STANDOUT, INDEX(5, 10)->p_drawn);
+    assert_int_equal(PASSAGE, INDEX(5, 12)->p_drawn);
+    assert_int_equal('K', mvinch(5, 10) & A_CHARTEXT);
+    assert_true(mvinch(5, 10) & A_STANDOUT);
+    assert_int_equal(PASSAGE, mvinch(5, 12) & A_CHARTEXT);
+    assert_int_equal('Q', mvinch(5, 11) & A_CHARTEXT);
+
+    /* Nothing changed since, so nothing goes out */
+    mvaddch(5, 10, 'Q');
+    flush_map();
+    assert_int_equal('Q', mvinch(5, 10) & A_CHARTEXT);
+
+    endwin();
+    delscreen(scr);
+    stdscr = NULL;
+    fclose(out);
+    fclose(in);
+}
+
+/* Test: without --More--, messages go by without a key and are all logged */
+static void test_msg_log_without_more(void **state) {
+    (void) state;
+    FILE *out = fopen("/dev/null", "w");
+    FILE *in = fopen("/dev/null", "r");
+    bool saved_more = more_msg;
+    SCREEN *scr;
+    long turn;
+    int n;
+
+    assert_non_null(out);
+    assert_non_null(in);
+    scr = newterm("vt100", out, in);
+    assert_non_null(scr);
+    more_msg = FALSE;
+    endmsg();			/* whatever earlier tests left unsaid */
+    n = msg_count();
+    turns = 41;
+    msg("first");
+    turns = 42;
+    msg("second %d", 2);
+    more_msg = saved_more;
+    endwin();
+    delscreen(scr);
+    stdscr = NULL;
+    fclose(out);
+    fclose(in);
+
+    assert_int_equal(n + 2, msg_count());
+    assert_string_equal("Second 2", old_msg(0, &turn));
+    assert_int_equal(42, turn);
+    assert_string_equal("First", old_msg(1, &turn));
+    assert_int_equal(41, turn);
+    assert_null(old_msg(-1, NULL));
+    assert_null(old_msg(MSGLOG, NULL));
+}
+
+/* Test: addmsg() pieces run together, and one too long is cut short */
+static void test_addmsg_builds_message(void **state) {
+    (void) state;
+    FILE *out = fopen("/dev/null", "w");
+    FILE *in = fopen("/dev/null", "r");
+    bool saved_more = more_msg;
+    char big[MAXSTR];
+    SCREEN *scr;
+
+    assert_non_null(out);
+    assert_non_null(in);
+    scr = newterm("vt100", out, in);
+    assert_non_null(scr);
+    more_msg = FALSE;
+    endmsg();
+    addmsg("the %s ", "bat");
+    addmsg("hits");
+    msg(" you %d times", 3);
+    assert_string_equal("The bat hits you 3 times", old_msg(0, NULL));
+
+    memset(big, 'x', sizeof big - 1);
+    big[sizeof big - 1] = '\0';
+    addmsg("short");
+    msg("%s", big);
+    assert_string_equal("Short", old_msg(1, NULL));
+    assert_true(strlen(old_msg(0, NULL)) < sizeof big - 1);
+    assert_int_equal('X', old_msg(0, NULL)[0]);
+
+    more_msg = saved_more;
+    endwin();
+    delscreen(scr);
+    stdscr = NULL;
+    fclose(out);
+    fclose(in);
+}
+
+/* The status line as it is on stdscr, without the blanks after it */
+static void status_line(char *line) {
+    int n;
+
+    mvinnstr(STATLINE, 0, line, NUMCOLS);
+    for (n = (int) strlen(line); n > 0 && line[n - 1] == ' '; n--)
+        continue;
+    line[n] = '\0';
+}
+
+/* Test: status() redraws just what changed, and moves what comes after */
+static void test_status_fields(void **state) {
+    (void) state;
+    FILE *out = fopen("/dev/null", "w");
+    FILE *in = fopen("/dev/null", "r");
+    THING *saved_armor = cur_armor;
+    struct stats saved_pstats = pstats, saved_max_stats = max_stats;
+    int saved_level = level, saved_purse = purse, saved_max_hp = max_hp;
+    int saved_hungry = hungry_state;
+    SCREEN *scr;
+    char line[NUMCOLS + 1];
+
+    assert_non_null(out);
+    assert_non_null(in);
+    scr = newterm("vt100", out, in);
+    assert_non_null(scr);
+    cur_armor = NULL;
+    level = 9;
+    purse = 0;
+    pstats.s_hpt = 12;
+    max_hp = 12;
+    pstats.s_str = 16;
+    max_stats.s_str = 16;
+    pstats.s_arm = 6;
+    pstats.s_lvl = 1;
+    pstats.s_exp = 0;
+    hungry_state = 0;
+    wipe_status();
+    status();
+    status_line(line);
+    assert_string_equal("Level: 9  Gold: 0      Hp: 12(12)  Str: 16(16)  Arm: 4   Exp: 1/0",
+        line);
+
+    pstats.s_hpt = 3;
+    status();
+    status_line(line);
+    assert_string_equal("Level: 9  Gold: 0      Hp:  3(12)  Str: 16(16)  Arm: 4   Exp: 1/0",
+        line);
+
+    level = 10;
+    hungry_state = 1;
+    status();
+    status_line(line);
+    assert_string_equal("Level: 10  Gold: 0      Hp:  3(12)  Str: 16(16)  Arm: 4   Exp: 1/0  Hungry",
+        line);
+
+    cur_armor = saved_armor;
+    pstats = saved_pstats;
+    max_stats = saved_max_stats;
+    level = saved_level;
+    purse = saved_purse;
+    max_hp = saved_max_hp;
+    hungry_state = saved_hungry;
+    endwin();
+    delscreen(scr);
+    stdscr = NULL;
+    fclose(out);
+    fclose(in);
+}
+
 int run_io_tests(void) {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_step_ok_blocks_walls),
         cmocka_unit_test(test_step_ok_allows_other_tiles),
+        cmocka_unit_test(test_mvshow_remembers_map),
+        cmocka_unit_test(test_flush_map_draws_changes),
+        cmocka_unit_test(test_msg_log_without_more),
+        cmocka_unit_test(test_addmsg_builds_message),
+        cmocka_unit_test(test_status_fields),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
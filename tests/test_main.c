@@ -37,19 +37,24 @@ extern int run_daemon_tests(void);
 extern int run_command_tests(void);
 extern int run_daemons_tests(void);
 extern int run_extern_tests(void);
+extern int run_game_tests(void);
 extern int run_init_tests(void);
 extern int run_io_tests(void);
 extern int run_mach_dep_tests(void);
 extern int run_mdport_tests(void);
 extern int run_new_level_tests(void);
+extern int run_observe_tests(void);
 extern int run_options_tests(void);
 extern int run_passages_tests(void);
+extern int run_record_tests(void);
 extern int run_rip_tests(void);
 extern int run_rooms_tests(void);
 extern int run_save_tests(void);
 extern int run_state_tests(void);
+extern int run_ttyrec_tests(void);
 extern int run_utils_tests(void);
 extern int run_vers_tests(void);
+extern int run_watch_tests(void);
 extern int run_wizard_tests(void);
 extern int run_xcrypt_tests(void);
 
@@ -251,6 +256,9 @@ int main(void) {
     printf("\n--- Extern Tests ---\n");
     failed += run_extern_tests();
 
+    printf("\n--- Game Tests ---\n");
+    failed += run_game_tests();
+
     printf("\n--- Init Tests ---\n");
     failed += run_init_tests();
 
@@ -266,12 +274,18 @@ int main(void) {
     printf("\n--- New Level Tests ---\n");
     failed += run_new_level_tests();
 
+    printf("\n--- Observe Tests ---\n");
+    failed += run_observe_tests();
+
     printf("\n--- Options Tests ---\n");
     failed += run_options_tests();
 
     printf("\n--- Passages Tests ---\n");
     failed += run_passages_tests();
 
+    printf("\n--- Record Tests ---\n");
+    failed += run_record_tests();
+
     printf("\n--- RIP Tests ---\n");
     failed += run_rip_tests();
 
@@ -284,12 +298,18 @@ int main(void) {
     printf("\n--- State Tests ---\n");
     failed += run_state_tests();
 
+    printf("\n--- Ttyrec Tests ---\n");
+    failed += run_ttyrec_tests();
+
     printf("\n--- Utils Tests ---\n");
     failed += run_utils_tests();
 
     printf("\n--- Version Tests ---\n");
     failed += run_vers_tests();
 
+    printf("\n--- Watch Tests ---\n");
+    failed += run_watch_tests();
+
     printf("\n--- Wizard Tests ---\n");
     failed += run_wizard_tests();
 
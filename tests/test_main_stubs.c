@@ -45,3 +45,9 @@ playit(void)
 {
     /* Not used in tests. */
 }
+
+void
+start_game(void)
+{
+    /* Not used in tests. */
+}
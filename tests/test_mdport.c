@@ -16,6 +16,7 @@ extern char *md_getusername(void);
 extern char *md_gethomedir(void);
 extern void md_sleep(int s);
 extern char *md_getshell(void);
+extern int md_keydecode(const unsigned char *buf, int len, int *used, bool more);
 
 /* Test: md_getpid() returns a positive value */
 static void test_md_getpid_positive(void **state) {
@@ -58,6 +59,39 @@ static void test_md_getshell_nonempty(void **state) {
     assert_true(strlen(shell) > 0);
 }
 
+/* Test: md_keydecode() picks keys and sequences out of a burst */
+static void test_md_keydecode_burst(void **state) {
+    (void) state;
+    const unsigned char *buf = (const unsigned char *) "a\033Ox\033\033[5~\033z";
+    int len = (int) strlen((const char *) buf);
+    int pos = 0, used;
+
+    assert_int_equal(md_keydecode(buf + pos, len - pos, &used, TRUE), 'a');
+    pos += used;
+    assert_int_equal(md_keydecode(buf + pos, len - pos, &used, TRUE), 'k');
+    assert_int_equal(used, 3);
+    pos += used;
+    assert_int_equal(md_keydecode(buf + pos, len - pos, &used, TRUE), CTRL('U'));
+    assert_int_equal(used, 5);
+    pos += used;
+    /* An ESC that starts nothing known gives the key after it */
+    assert_int_equal(md_keydecode(buf + pos, len - pos, &used, TRUE), 'z');
+    assert_int_equal(pos + used, len);
+}
+
+/* Test: md_keydecode() waits for the rest of a sequence, or gives ESC */
+static void test_md_keydecode_partial(void **state) {
+    (void) state;
+    const unsigned char *buf = (const unsigned char *) "\033[";
+    int used;
+
+    assert_int_equal(md_keydecode(buf, 2, &used, TRUE), -1);
+    assert_int_equal(md_keydecode(buf, 2, &used, FALSE), ESCAPE);
+    assert_int_equal(used, 2);
+    assert_int_equal(md_keydecode(buf, 1, &used, FALSE), ESCAPE);
+    assert_int_equal(used, 1);
+}
+
 int run_mdport_tests(void) {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_md_getpid_positive),
@@ -65,6 +99,8 @@ int run_mdport_tests(void) {
         cmocka_unit_test(test_md_gethomedir_returns_path),
         cmocka_unit_test(test_md_sleep_zero),
         cmocka_unit_test(test_md_getshell_nonempty),
+        cmocka_unit_test(test_md_keydecode_burst),
+        cmocka_unit_test(test_md_keydecode_partial),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -8,6 +8,7 @@
 #include <cmocka.h>
 #include <stdlib.h>
 #include <limits.h>
+#include <string.h>
 #include <stdbool.h>
 
 /* Include curses and rogue.h for correct type definitions */
@@ -224,6 +225,159 @@ static void test_rnd_thing_variety(void **state) {
     level = old_level;
 }
 
+/* Test: find_obj() looks objects up through the per-spot index */
+static void test_find_obj_indexed(void **state) {
+    (void) state; /* unused */
+    THING *obj = new_item();
+
+    lvl_obj = NULL;
+    index_objs();
+    obj->o_pos.y = 5;
+    obj->o_pos.x = 10;
+    attach_obj(obj);
+    assert_ptr_equal(obj, find_obj(5, 10));
+    assert_null(obat(5, 11));
+
+    detach_obj(obj);
+    assert_null(lvl_obj);
+    assert_null(obat(5, 10));
+    discard(obj);
+}
+
+/* Test: detach_obj() uncovers an object stacked on the same spot */
+static void test_detach_obj_stacked(void **state) {
+    (void) state; /* unused */
+    THING *under = new_item();
+    THING *over = new_item();
+
+    lvl_obj = NULL;
+    index_objs();
+    under->o_pos.y = over->o_pos.y = 3;
+    under->o_pos.x = over->o_pos.x = 7;
+    attach_obj(under);
+    attach_obj(over);
+    assert_ptr_equal(over, find_obj(3, 7));
+
+    detach_obj(over);
+    assert_ptr_equal(under, find_obj(3, 7));
+    detach_obj(under);
+    assert_null(obat(3, 7));
+    discard(over);
+    discard(under);
+}
+
+/* Test: detach_obj() keeps the rest of a spot's stack in order, as index_objs() builds it */
+static void test_detach_obj_middle(void **state) {
+    (void) state; /* unused */
+    THING *obj[3];
+    int i;
+
+    lvl_obj = NULL;
+    index_objs();
+    for (i = 0; i < 3; i++)
+    {
+        obj[i] = new_item();
+        obj[i]->o_pos.y = 4;
+        obj[i]->o_pos.x = 9;
+        attach_obj(obj[i]);
+    }
+    detach_obj(obj[1]);
+    assert_null(obj[1]->o_under);
+    assert_ptr_equal(obj[2], obat(4, 9));
+    assert_ptr_equal(obj[0], obj[2]->o_under);
+    assert_null(obj[0]->o_under);
+
+    index_objs();
+    assert_ptr_equal(obj[2], obat(4, 9));
+    assert_ptr_equal(obj[0], obj[2]->o_under);
+    assert_null(obj[0]->o_under);
+
+    detach_obj(obj[2]);
+    detach_obj(obj[0]);
+    assert_null(obat(4, 9));
+    assert_null(lvl_obj);
+    for (i = 0; i < 3; i++)
+        discard(obj[i]);
+}
+
+/* Test: set_dest() moves a monster's claim from one object to another */
+static void test_set_dest_moves_claim(void **state) {
+    (void) state; /* unused */
+    THING monster;
+    THING *first = new_item();
+    THING *second = new_item();
+
+    memset(&monster, 0, sizeof monster);
+    lvl_obj = NULL;
+    index_objs();
+    first->o_pos.y = 3;
+    first->o_pos.x = 3;
+    second->o_pos.y = 4;
+    second->o_pos.x = 4;
+    attach_obj(first);
+    attach_obj(second);
+
+    set_dest(&monster, &first->o_pos);
+    assert_ptr_equal(&monster, first->o_claim);
+
+    set_dest(&monster, &second->o_pos);
+    assert_null(first->o_claim);
+    assert_ptr_equal(&monster, second->o_claim);
+
+    set_dest(&monster, &hero);
+    assert_null(second->o_claim);
+    detach_obj(first);
+    detach_obj(second);
+    discard(first);
+    discard(second);
+}
+
+/* Test: unclaim() sends the claiming monster after the hero */
+static void test_unclaim_redirects_monster(void **state) {
+    (void) state; /* unused */
+    THING monster;
+    THING *obj = new_item();
+
+    memset(&monster, 0, sizeof monster);
+    lvl_obj = NULL;
+    index_objs();
+    obj->o_pos.y = 3;
+    obj->o_pos.x = 3;
+    attach_obj(obj);
+
+    set_dest(&monster, &obj->o_pos);
+    unclaim(obj);
+    assert_null(obj->o_claim);
+    assert_ptr_equal(&hero, monster.t_dest);
+    detach_obj(obj);
+    discard(obj);
+}
+
+/* Test: index_objs() gives back claims from where monsters are running to */
+static void test_index_objs_rebuilds_claims(void **state) {
+    (void) state; /* unused */
+    THING *saved_mlist = mlist;
+    THING monster;
+    THING *obj = new_item();
+
+    memset(&monster, 0, sizeof monster);
+    lvl_obj = NULL;
+    mlist = NULL;
+    obj->o_pos.y = 6;
+    obj->o_pos.x = 8;
+    attach(lvl_obj, obj);
+    attach(mlist, &monster);
+    monster.t_dest = &obj->o_pos;
+
+    index_objs();
+    assert_ptr_equal(obj, obat(6, 8));
+    assert_ptr_equal(&monster, obj->o_claim);
+
+    detach_obj(obj);
+    discard(obj);
+    mlist = saved_mlist;
+}
+
 int run_misc_tests(void) {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_sign_edge_cases),
@@ -245,6 +399,12 @@ int run_misc_tests(void) {
         cmocka_unit_test(test_is_current_not_equipped),
         cmocka_unit_test(test_rnd_thing_valid),
         cmocka_unit_test(test_rnd_thing_variety),
+        cmocka_unit_test(test_find_obj_indexed),
+        cmocka_unit_test(test_detach_obj_stacked),
+        cmocka_unit_test(test_detach_obj_middle),
+        cmocka_unit_test(test_set_dest_moves_claim),
+        cmocka_unit_test(test_unclaim_redirects_monster),
+        cmocka_unit_test(test_index_objs_rebuilds_claims),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -5,6 +5,11 @@
 #include <stdarg.h>
 #include <stddef.h>
 #include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <unistd.h>
 #include <cmocka.h>
 #include <curses.h>
 #include "rogue.h"
@@ -23,9 +28,260 @@ static void test_rnd_room_finds_valid_room(void **state) {
     assert_int_equal(3, rnd_room());
 }
 
+/* Empty the map and lists, as new_level() does before digging */
+static void empty_level(void) {
+    THING *tp;
+
+    for (int i = 0; i < MAXLINES * MAXCOLS; i++) {
+        places[i].p_ch = ' ';
+        places[i].p_flags = F_REAL;
+        places[i].p_pnum = 0;
+        places[i].p_monst = NULL;
+        places[i].p_obj = NULL;
+    }
+    for (tp = mlist; tp != NULL; tp = next(tp))
+        free_list(tp->t_pack);
+    free_list(mlist);
+    free_list(lvl_obj);
+    index_rooms();
+}
+
+static int list_length(THING *list) {
+    int n = 0;
+
+    for (; list != NULL; list = next(list))
+        n++;
+    return n;
+}
+
+/* Test: a level handed back by the level cache is the level that was dug */
+static void test_level_cache_gives_back_same_level(void **state) {
+    (void) state;
+    static char ch[MAXLINES * MAXCOLS], fl[MAXLINES * MAXCOLS];
+    coord dug_stairs;
+    int nobj, nmon, ors, food;
+    THING *tp;
+
+    rng_seed(RNG_FAST, 1234);
+    level = max_level = 4;
+    level_cache = TRUE;
+    cache_dir[0] = '\0';
+    ors = rng_use(RS_LEVEL);
+    food = no_food;
+
+    empty_level();
+    rng_level(level);
+    assert_false(load_level());
+    dig_level();
+    keep_level();
+    for (int i = 0; i < MAXLINES * MAXCOLS; i++) {
+        ch[i] = places[i].p_ch;
+        fl[i] = places[i].p_flags;
+    }
+    dug_stairs = stairs;
+    nobj = list_length(lvl_obj);
+    nmon = list_length(mlist);
+
+    /* Digging moves no_food on, so put back what it was dug with */
+    empty_level();
+    rng_level(level);
+    no_food = food;
+    assert_true(load_level());
+    for (int i = 0; i < MAXLINES * MAXCOLS; i++) {
+        assert_int_equal(ch[i], places[i].p_ch);
+        assert_int_equal(fl[i], places[i].p_flags);
+    }
+    assert_int_equal(dug_stairs.y, stairs.y);
+    assert_int_equal(dug_stairs.x, stairs.x);
+    assert_int_equal(nobj, list_length(lvl_obj));
+    assert_int_equal(nmon, list_length(mlist));
+    for (tp = mlist; tp != NULL; tp = next(tp))
+        assert_ptr_equal(tp, moat(tp->t_pos.y, tp->t_pos.x));
+
+    /* A different depth is not in the cache */
+    empty_level();
+    level = max_level = 5;
+    rng_level(level);
+    assert_false(load_level());
+
+    flush_levels();
+    level_cache = FALSE;
+    rng_use(ors);
+    empty_level();
+}
+
+/* Test: a level kept on disk is read back whole, and no part-written file is left */
+static void test_level_cache_on_disk(void **state) {
+    (void) state;
+    static char ch[MAXLINES * MAXCOLS];
+    char dir[] = "/tmp/rogue_levelsXXXXXX";
+    char path[sizeof dir + 300];
+    struct dirent *dp;
+    DIR *dirp;
+    coord dug_stairs;
+    int nobj, nmon, nfiles, ors, food;
+
+    assert_non_null(mkdtemp(dir));
+    rng_seed(RNG_FAST, 4321);
+    level = max_level = 3;
+    level_cache = TRUE;
+    strcpy(cache_dir, dir);
+    ors = rng_use(RS_LEVEL);
+    food = no_food;
+
+    empty_level();
+    rng_level(level);
+    assert_false(load_level());
+    dig_level();
+    keep_level();
+    for (int i = 0; i < MAXLINES * MAXCOLS; i++)
+        ch[i] = places[i].p_ch;
+    dug_stairs = stairs;
+    nobj = list_length(lvl_obj);
+    nmon = list_length(mlist);
+
+    /* Only the finished file is there */
+    nfiles = 0;
+    assert_non_null(dirp = opendir(dir));
+    while ((dp = readdir(dirp)) != NULL) {
+        if (dp->d_name[0] == '.')
+            continue;
+        nfiles++;
+        assert_non_null(strstr(dp->d_name, ".lvl"));
+        assert_string_equal(".lvl", strstr(dp->d_name, ".lvl"));
+    }
+    closedir(dirp);
+    assert_int_equal(1, nfiles);
+
+    /* With memory forgotten, it has to come from the file */
+    flush_levels();
+    empty_level();
+    rng_level(level);
+    no_food = food;
+    assert_true(load_level());
+    for (int i = 0; i < MAXLINES * MAXCOLS; i++)
+        assert_int_equal(ch[i], places[i].p_ch);
+    assert_int_equal(dug_stairs.y, stairs.y);
+    assert_int_equal(dug_stairs.x, stairs.x);
+    assert_int_equal(nobj, list_length(lvl_obj));
+    assert_int_equal(nmon, list_length(mlist));
+
+    flush_levels();
+    assert_non_null(dirp = opendir(dir));
+    while ((dp = readdir(dirp)) != NULL) {
+        if (dp->d_name[0] == '.')
+            continue;
+        snprintf(path, sizeof path, "%s/%s", dir, dp->d_name);
+        unlink(path);
+    }
+    closedir(dirp);
+    rmdir(dir);
+    cache_dir[0] = '\0';
+    level_cache = FALSE;
+    rng_use(ors);
+    empty_level();
+}
+
+/* Test: dig_ahead() keeps the level below without touching this one */
+static void test_dig_ahead_keeps_next_level(void **state) {
+    (void) state;
+    static char ch[MAXLINES * MAXCOLS];
+    coord here_stairs;
+    int nobj, nmon, ors, food;
+    THING *tp;
+
+    rng_seed(RNG_FAST, 99);
+    level = max_level = 2;
+    pre_dig = TRUE;
+    cache_dir[0] = '\0';
+    ors = rng_use(RS_LEVEL);
+    empty_level();
+    rng_level(level);
+    dig_level();
+    rng_use(ors);
+    for (int i = 0; i < MAXLINES * MAXCOLS; i++)
+        ch[i] = places[i].p_ch;
+    here_stairs = stairs;
+    nobj = list_length(lvl_obj);
+    nmon = list_length(mlist);
+    food = no_food;
+    for (int i = 0; i < MAXLINES * MAXCOLS; i++)
+        places[i].p_show = places[i].p_drawn = 'Z';
+
+    dig_ahead();
+    assert_int_equal(2, level);
+    assert_int_equal(2, max_level);
+    assert_int_equal(food, no_food);
+    assert_ptr_equal(&streams[RS_MAIN], rng);
+    for (int i = 0; i < MAXLINES * MAXCOLS; i++) {
+        assert_int_equal(ch[i], places[i].p_ch);
+        assert_int_equal('Z', places[i].p_show);
+    }
+    assert_int_equal(here_stairs.y, stairs.y);
+    assert_int_equal(here_stairs.x, stairs.x);
+    assert_int_equal(nobj, list_length(lvl_obj));
+    assert_int_equal(nmon, list_length(mlist));
+
+    /* Going down now finds the level already dug */
+    level = max_level = 3;
+    rng_level(level);
+    ors = rng_use(RS_LEVEL);
+    empty_level();
+    assert_true(load_level());
+    /* Its monsters did not see what is on this level's screen */
+    for (tp = mlist; tp != NULL; tp = next(tp))
+        assert_int_not_equal('Z', tp->t_oldch);
+
+    flush_levels();
+    pre_dig = FALSE;
+    rng_use(ors);
+    empty_level();
+}
+
+/* Test: dig_ahead() leaves the level alone while monsters are aggravated */
+static void test_dig_ahead_not_while_aggravating(void **state) {
+    (void) state;
+    THING ring;
+    RNG monst;
+    int ors;
+
+    rng_seed(RNG_FAST, 99);
+    level = max_level = 2;
+    pre_dig = TRUE;
+    cache_dir[0] = '\0';
+    memset(&ring, 0, sizeof ring);
+    ring.o_type = RING;
+    ring.o_which = R_AGGR;
+    cur_ring[LEFT] = &ring;
+    ors = rng_use(RS_LEVEL);
+    empty_level();
+    rng_level(level);
+    dig_level();
+    rng_use(ors);
+    monst = streams[RS_MONST];
+
+    dig_ahead();
+    assert_true(monst.r_state == streams[RS_MONST].r_state);
+    level = max_level = 3;
+    rng_level(level);
+    ors = rng_use(RS_LEVEL);
+    empty_level();
+    assert_false(load_level());
+
+    cur_ring[LEFT] = NULL;
+    flush_levels();
+    pre_dig = FALSE;
+    rng_use(ors);
+    empty_level();
+}
+
 int run_new_level_tests(void) {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_rnd_room_finds_valid_room),
+        cmocka_unit_test(test_level_cache_gives_back_same_level),
+        cmocka_unit_test(test_level_cache_on_disk),
+        cmocka_unit_test(test_dig_ahead_keeps_next_level),
+        cmocka_unit_test(test_dig_ahead_not_while_aggravating),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -0,0 +1,112 @@
+/*
+ * Tests for observe.c
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <string.h>
+#include <cmocka.h>
+#include <curses.h>
+#include "rogue.h"
+#include "observe.h"
+
+/* Test: write_obs() writes the header, the map as shown and the monsters seen */
+static void test_write_obs_record(void **state) {
+    (void) state;
+    THING monst;
+    THING *saved_mlist = mlist, *saved_pack = pack;
+    OBHEAD head;
+    OBMONST om;
+    static char map[NUMLINES * NUMCOLS];
+    FILE *fp;
+
+    for (int i = 0; i < MAXLINES * MAXCOLS; i++) {
+        places[i].p_show = ' ';
+    }
+    shown(5, 10) = '@';
+    shown(5, 11) = 'K';
+    shown(6, 11) = '#';
+    memset(&monst, 0, sizeof monst);
+    monst.t_pos.y = 5;
+    monst.t_pos.x = 11;
+    mlist = &monst;
+    pack = NULL;
+    hero.y = 5;
+    hero.x = 10;
+    level = 4;
+    purse = 37;
+    strcpy(huh, "hello");
+
+    /* Messages shown by earlier tests go out with the first record */
+    fp = tmpfile();
+    assert_non_null(fp);
+    write_obs(fp);
+    fclose(fp);
+
+    fp = tmpfile();
+    assert_non_null(fp);
+    write_obs(fp);
+    write_obs(fp);
+    mlist = saved_mlist;
+    pack = saved_pack;
+    rewind(fp);
+
+    assert_int_equal(1, fread(&head, sizeof head, 1, fp));
+    assert_int_equal(OB_MAGIC, head.ob_magic);
+    assert_int_equal(sizeof head + sizeof map + sizeof om, head.ob_size);
+    assert_int_equal(NUMLINES, head.ob_lines);
+    assert_int_equal(NUMCOLS, head.ob_cols);
+    assert_int_equal(1, head.ob_nmonst);
+    assert_int_equal(0, head.ob_npack);
+    assert_int_equal(4, head.ob_level);
+    assert_int_equal(5, head.ob_y);
+    assert_int_equal(10, head.ob_x);
+    assert_int_equal(37, head.ob_purse);
+    assert_string_equal("hello", head.ob_msg);
+
+    assert_int_equal(1, fread(map, sizeof map, 1, fp));
+    assert_int_equal('@', map[5 * NUMCOLS + 10]);
+    assert_int_equal('#', map[6 * NUMCOLS + 11]);
+    assert_int_equal(1, fread(&om, sizeof om, 1, fp));
+    assert_int_equal(5, om.om_y);
+    assert_int_equal(11, om.om_x);
+    assert_int_equal('K', om.om_ch);
+
+    uint32_t seq = head.ob_seq;
+    assert_int_equal(1, fread(&head, sizeof head, 1, fp));
+    assert_int_equal(seq + 1, head.ob_seq);
+    fclose(fp);
+}
+
+/* Test: an action answers the questions a command asks once, then ESCAPE does */
+static void test_action_answers_questions(void **state) {
+    (void) state;
+    ACTION act;
+    extern int gethand(void);
+
+    memset(&act, 0, sizeof act);
+    act.a_cmd = 'P';
+    act.a_hand = 'r';
+    act.a_dir = 'b';
+    action = &act;
+    player.t_flags &= ~ISHUH;
+
+    assert_int_equal(RIGHT, gethand());
+    assert_int_equal(-1, gethand());
+    assert_true(get_dir());
+    assert_int_equal(1, delta.y);
+    assert_int_equal(-1, delta.x);
+    assert_false(get_dir());
+    assert_int_equal(ESCAPE, readchar());
+    action = NULL;
+}
+
+int run_observe_tests(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_write_obs_record),
+        cmocka_unit_test(test_action_answers_questions),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
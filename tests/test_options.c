@@ -37,10 +37,23 @@ static void test_option_inventory_entry(void **state) {
     assert_ptr_equal(&inv_type, optlist[6].o_opt);
 }
 
+/* Test: numeric and boolean options parse from ROGUEOPTS */
+static void test_parse_opts_framerate(void **state) {
+    char opts[] = "framerate=20,noanimate";
+    (void) state;
+
+    parse_opts(opts);
+    assert_int_equal(20, frame_rate);
+    assert_false(animate);
+    frame_rate = 0;
+    animate = TRUE;
+}
+
 int run_options_tests(void) {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_option_terse_entry),
         cmocka_unit_test(test_option_inventory_entry),
+        cmocka_unit_test(test_parse_opts_framerate),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
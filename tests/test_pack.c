@@ -248,7 +248,7 @@ static void test_pick_up_normal_item(void **state) {
     hero.y = 5; hero.x = 5;
     THING *obj = create_item(SCROLL, 0, 1);
     obj->o_pos = hero;
-    lvl_obj = obj; /* Item is on the floor */
+    attach_obj(obj); /* Item is on the floor */
 
     pick_up(SCROLL);
     assert_int_equal(inpack, 1);
@@ -263,7 +263,7 @@ static void test_pick_up_full_pack(void **state) {
     inpack = MAXPACK;
     THING *obj = create_item(SCROLL, 0, 1);
     obj->o_pos = hero;
-    lvl_obj = obj;
+    attach_obj(obj);
 
     pick_up(SCROLL);
     assert_int_equal(inpack, MAXPACK);
@@ -27,9 +27,93 @@ static void test_passnum_no_exits(void **state) {
     assert_int_equal(0, passages[0].r_nexits);
 }
 
+/* Test: conn() finds a door out of a maze whose bottom edge only opens at a corner */
+static void test_conn_maze_corner_exit(void **state) {
+    (void) state;
+
+    for (int i = 0; i < MAXLINES * MAXCOLS; i++) {
+        places[i].p_ch = ' ';
+        places[i].p_flags = F_REAL;
+        places[i].p_pnum = 0;
+    }
+    for (int i = 0; i < MAXROOMS; i++) {
+        rooms[i].r_nexits = 0;
+        rooms[i].r_flags = 0;
+    }
+    rng_seed(RNG_LEGACY, 1);
+    level = 1;
+    rooms[0].r_flags = ISMAZE;
+    rooms[0].r_pos.y = 1;
+    rooms[0].r_pos.x = 1;
+    rooms[0].r_max.y = 6;
+    rooms[0].r_max.x = 25;
+    rooms[3].r_pos.y = 9;
+    rooms[3].r_pos.x = 1;
+    rooms[3].r_max.y = 5;
+    rooms[3].r_max.x = 10;
+    flat(6, 1) |= F_PASS;
+
+    conn(0, 3);
+
+    assert_int_equal(1, rooms[0].r_nexits);
+    assert_int_equal(6, rooms[0].r_exit[0].y);
+    assert_int_equal(1, rooms[0].r_exit[0].x);
+}
+
+/* Count the passage spots joined to (y, x), marking them as seen */
+static int flood_passage(int y, int x) {
+    if (y <= 0 || y >= NUMLINES || x < 0 || x >= NUMCOLS)
+        return 0;
+    if (!(flat(y, x) & F_PASS) || (flat(y, x) & F_SEEN))
+        return 0;
+    flat(y, x) |= F_SEEN;
+    return 1 + flood_passage(y + 1, x) + flood_passage(y - 1, x)
+        + flood_passage(y, x + 1) + flood_passage(y, x - 1);
+}
+
+/* Test: do_passages() joins every room on the grid */
+static void test_do_passages_joins_every_room(void **state) {
+    (void) state;
+
+    for (int i = 0; i < MAXLINES * MAXCOLS; i++) {
+        places[i].p_ch = ' ';
+        places[i].p_flags = F_REAL;
+        places[i].p_pnum = 0;
+    }
+    /* with every room gone, the passages all run into each other */
+    for (int i = 0; i < MAXROOMS; i++) {
+        rooms[i].r_nexits = 0;
+        rooms[i].r_flags = ISGONE;
+        rooms[i].r_pos.x = (i % ROOMSX) * (NUMCOLS / ROOMSX) + 3;
+        rooms[i].r_pos.y = (i / ROOMSX) * (NUMLINES / ROOMSY) + 3;
+        rooms[i].r_max.x = -NUMCOLS;
+        rooms[i].r_max.y = -NUMLINES;
+    }
+    rng_seed(RNG_LEGACY, 1);
+    level = 1;
+
+    do_passages();
+
+    int dug = 0;
+    for (int y = 1; y < NUMLINES; y++) {
+        for (int x = 0; x < NUMCOLS; x++) {
+            if (flat(y, x) & F_PASS) {
+                dug++;
+            }
+        }
+    }
+    assert_int_equal(dug, flood_passage(rooms[0].r_pos.y, rooms[0].r_pos.x));
+    for (int i = 0; i < MAXROOMS; i++) {
+        assert_true(flat(rooms[i].r_pos.y, rooms[i].r_pos.x) & F_SEEN);
+    }
+    assert_true(passages[1].r_flags & ISGONE);
+}
+
 int run_passages_tests(void) {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_passnum_no_exits),
+        cmocka_unit_test(test_conn_maze_corner_exit),
+        cmocka_unit_test(test_do_passages_joins_every_room),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -247,6 +247,48 @@ static void test_quaff_no_potion(void **state) {
 }
 
 /* Test suite runner */
+/* Test: inv_name() keeps a potion's name until what it was made from changes */
+static void test_inv_name_kept_until_changed(void **state) {
+    (void) state;
+
+    THING obj;
+    char first[MAXSTR];
+    bool saved_know = pot_info[0].oi_know;
+    char *saved_color = p_colors[0];
+
+    memset(&obj, 0, sizeof(THING));
+    p_colors[0] = "blue";
+    obj.o_type = POTION;
+    obj.o_which = 0;
+    obj.o_count = 1;
+    pot_info[0].oi_know = FALSE;
+
+    strcpy(first, inv_name(&obj, FALSE));
+    assert_string_equal(first, obj.o_invname);
+    assert_string_equal(first, inv_name(&obj, FALSE));
+
+    /* Knowing the kind makes it again */
+    pot_info[0].oi_know = TRUE;
+    assert_true(strcmp(first, inv_name(&obj, FALSE)) != 0);
+    pot_info[0].oi_know = FALSE;
+    assert_string_equal(first, inv_name(&obj, FALSE));
+
+    /* So does having more of it */
+    obj.o_count = 2;
+    assert_true(strcmp(first, inv_name(&obj, FALSE)) != 0);
+    obj.o_count = 1;
+    assert_string_equal(first, inv_name(&obj, FALSE));
+
+    /* What it was made from but does not keep needs forget_names() */
+    strcpy(obj.o_invname, "stale");
+    assert_string_equal("Stale", inv_name(&obj, FALSE));
+    forget_names();
+    assert_string_equal(first, inv_name(&obj, FALSE));
+
+    pot_info[0].oi_know = saved_know;
+    p_colors[0] = saved_color;
+}
+
 int run_potions_tests(void) {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_is_magic_armor_protected),
@@ -267,6 +309,7 @@ int run_potions_tests(void) {
         cmocka_unit_test(test_raise_level_increases_exp),
         cmocka_unit_test(test_do_pot_unknown),
         cmocka_unit_test(test_quaff_no_potion),
+        cmocka_unit_test(test_inv_name_kept_until_changed),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
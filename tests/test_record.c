@@ -0,0 +1,82 @@
+/*
+ * Tests for record.c
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <cmocka.h>
+#include <curses.h>
+#include "rogue.h"
+
+/* Test: keys written by a recording come back from a replay, with its seed and options */
+static void test_record_then_replay(void **state) {
+    (void) state;
+    char name[] = "/tmp/rogue_keysXXXXXX";
+    int fd, saved_dnum = dnum;
+    bool saved_fast = fast_rng, saved_passgo = passgo, saved_terse = terse;
+    char saved_who[MAXSTR];
+
+    fd = mkstemp(name);
+    assert_true(fd >= 0);
+    close(fd);
+    strcpy(saved_who, whoami);
+    setenv("ROGUEOPTS", "passgo,observe=/tmp/nowhere", 1);
+
+    strcpy(rec_file, name);
+    dnum = 4242;
+    fast_rng = TRUE;
+    terse = TRUE;
+    strcpy(whoami, "tester");
+    start_record();
+    turns = 1;
+    record_key('h');
+    turns = 3;
+    record_key('s');
+    record_key(ESCAPE);
+    end_record();
+
+    dnum = 0;
+    fast_rng = FALSE;
+    passgo = FALSE;
+    terse = FALSE;
+    whoami[0] = '\0';
+    assert_true(start_replay(name));
+    replay_opts();
+    assert_int_equal(4242, dnum);
+    assert_true(fast_rng);
+    assert_true(passgo);
+    assert_true(terse);
+    assert_string_equal("tester", whoami);
+    assert_string_equal("", obs_file);
+    assert_string_equal("", rec_file);
+    turns = 1;
+    assert_int_equal('h', replay_key());
+    turns = 3;
+    assert_int_equal('s', replay_key());
+    assert_int_equal(ESCAPE, replay_key());
+
+    replaying = FALSE;
+    headless = FALSE;
+    noscore = FALSE;
+    turns = 0;
+    dnum = saved_dnum;
+    fast_rng = saved_fast;
+    passgo = saved_passgo;
+    terse = saved_terse;
+    strcpy(whoami, saved_who);
+    unsetenv("ROGUEOPTS");
+    unlink(name);
+}
+
+int run_record_tests(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_record_then_replay),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
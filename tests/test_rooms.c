@@ -29,7 +29,7 @@ static int setup_rooms_suite(void **state) {
     (void) state;
     reset_places_grid();
     reset_rooms_state();
-    seed = 0;
+    rng_seed(RNG_LEGACY, 0);
     level = 1;
     return 0;
 }
@@ -157,6 +157,33 @@ static void test_find_floor_respects_limit(void **state) {
     assert_false(find_floor(&room, &where, 3, FALSE));
 }
 
+/* Test: find_floor() with no limit gives up on a room with no floor */
+static void test_find_floor_unlimited_gives_up(void **state) {
+    (void) state;
+
+    struct room room = { .r_pos = {1, 1}, .r_max = {6, 6}, .r_flags = 0 };
+    fill_room_interior(&room, ' ');
+
+    coord where;
+    assert_false(find_floor(&room, &where, 0, FALSE));
+}
+
+/* Test: with the fast generator find_floor() finds the only free spot */
+static void test_find_floor_fast_finds_last_spot(void **state) {
+    (void) state;
+
+    struct room room = { .r_pos = {1, 1}, .r_max = {20, 12}, .r_flags = 0 };
+    fill_room_interior(&room, FLOOR);
+    set_room_monsters(&room, &player);
+    INDEX(7, 13)->p_monst = NULL;
+    rng_seed(RNG_FAST, 5);
+
+    coord where;
+    assert_true(find_floor(&room, &where, 0, TRUE));
+    assert_int_equal(7, where.y);
+    assert_int_equal(13, where.x);
+}
+
 /* Test: find_floor() with monst=true requires walkable, unoccupied tiles */
 static void test_find_floor_monster_spot(void **state) {
     (void) state;
@@ -203,6 +230,127 @@ static void test_find_floor_with_null_room(void **state) {
     assert_in_range(where.y, first->r_pos.y + 1, first->r_pos.y + first->r_max.y - 2);
 }
 
+/* Test: wanderer() makes no monster when every spot is taken */
+static void test_wanderer_full_level(void **state) {
+    (void) state;
+    THING *saved_mlist = mlist;
+    struct room *saved_proom = proom;
+
+    rooms[0].r_pos.x = 1;
+    rooms[0].r_pos.y = 1;
+    rooms[0].r_max.x = 6;
+    rooms[0].r_max.y = 6;
+    draw_room(&rooms[0]);
+    set_room_monsters(&rooms[0], &player);
+    for (int i = 1; i < MAXROOMS; i++) {
+        rooms[i].r_flags = ISGONE;
+    }
+    mlist = NULL;
+    proom = NULL;
+
+    wanderer();
+    assert_null(mlist);
+    for (int y = 2; y < 6; y++) {
+        for (int x = 2; x < 6; x++) {
+            assert_ptr_equal(&player, moat(y, x));
+        }
+    }
+
+    mlist = saved_mlist;
+    proom = saved_proom;
+}
+
+/* Test: room_attach()/room_detach() keep a room's monster list in order */
+static void test_room_monster_list(void **state) {
+    (void) state;
+    THING a, b, c;
+
+    memset(&a, 0, sizeof a);
+    memset(&b, 0, sizeof b);
+    memset(&c, 0, sizeof c);
+    a.t_room = b.t_room = c.t_room = &rooms[0];
+    room_attach(&a);
+    room_attach(&b);
+    room_attach(&c);
+    assert_ptr_equal(rooms[0].r_monst, &c);
+    assert_ptr_equal(c.t_rnext, &b);
+    assert_ptr_equal(b.t_rnext, &a);
+
+    room_detach(&b);
+    assert_ptr_equal(c.t_rnext, &a);
+    assert_ptr_equal(a.t_rprev, &c);
+    room_detach(&c);
+    assert_ptr_equal(rooms[0].r_monst, &a);
+    room_detach(&a);
+    assert_null(rooms[0].r_monst);
+}
+
+/* Test: room lists stay in mlist order as monsters move between rooms */
+static void test_room_list_mlist_order(void **state) {
+    (void) state;
+    THING *saved_mlist = mlist;
+    int saved_seq = mon_seq;
+    THING a, b, c;
+
+    memset(&a, 0, sizeof a);
+    memset(&b, 0, sizeof b);
+    memset(&c, 0, sizeof c);
+    mlist = NULL;
+    attach(mlist, &a);
+    attach(mlist, &b);
+    attach(mlist, &c);
+    a.t_room = c.t_room = &rooms[0];
+    b.t_room = &rooms[1];
+    index_rooms();
+    assert_true(c.t_seq > b.t_seq && b.t_seq > a.t_seq);
+    assert_int_equal(c.t_seq, mon_seq);
+    assert_ptr_equal(&c, rooms[0].r_monst);
+    assert_ptr_equal(&a, c.t_rnext);
+    assert_ptr_equal(&b, rooms[1].r_monst);
+
+    /* a moves in behind b, c in front of it */
+    room_detach(&a);
+    a.t_room = &rooms[1];
+    room_attach(&a);
+    room_detach(&c);
+    c.t_room = &rooms[1];
+    room_attach(&c);
+    assert_null(rooms[0].r_monst);
+    assert_ptr_equal(&c, rooms[1].r_monst);
+    assert_ptr_equal(&b, c.t_rnext);
+    assert_ptr_equal(&a, b.t_rnext);
+    assert_null(a.t_rnext);
+    assert_ptr_equal(&b, a.t_rprev);
+
+    mlist = saved_mlist;
+    mon_seq = saved_seq;
+}
+
+/* Test: dig() reaches every cell of an odd sized maze and digs a tree */
+static void test_dig_maze_reaches_every_cell(void **state) {
+    (void) state;
+    MAZE maze = { .m_pos = {3, 2}, .m_max = {12, 8} };
+    int cells = 0, dug = 0;
+
+    level = 1;
+    flat(4 + maze.m_pos.y, 6 + maze.m_pos.x) |= F_PASS;
+    dig(&maze, 4, 6);
+    assert_int_equal(maze.m_depth, 0);
+    for (int y = 0; y <= maze.m_max.y; y++) {
+        for (int x = 0; x <= maze.m_max.x; x++) {
+            if (flat(y + maze.m_pos.y, x + maze.m_pos.x) & F_PASS) {
+                dug++;
+            }
+            if (y % 2 == 0 && x % 2 == 0) {
+                cells++;
+                assert_true(flat(y + maze.m_pos.y, x + maze.m_pos.x) & F_PASS);
+            }
+        }
+    }
+    /* every cell but the first is reached through exactly one new spot */
+    assert_int_equal(dug, 2 * cells - 1);
+}
+
 int run_rooms_tests(void) {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test_setup_teardown(test_rnd_pos_within_bounds, setup_rooms_suite, teardown_rooms_suite),
@@ -212,9 +360,15 @@ int run_rooms_tests(void) {
         cmocka_unit_test_setup_teardown(test_find_floor_regular_room, setup_rooms_suite, teardown_rooms_suite),
         cmocka_unit_test_setup_teardown(test_find_floor_maze_room, setup_rooms_suite, teardown_rooms_suite),
         cmocka_unit_test_setup_teardown(test_find_floor_respects_limit, setup_rooms_suite, teardown_rooms_suite),
+        cmocka_unit_test_setup_teardown(test_find_floor_unlimited_gives_up, setup_rooms_suite, teardown_rooms_suite),
+        cmocka_unit_test_setup_teardown(test_find_floor_fast_finds_last_spot, setup_rooms_suite, teardown_rooms_suite),
         cmocka_unit_test_setup_teardown(test_find_floor_monster_spot, setup_rooms_suite, teardown_rooms_suite),
         cmocka_unit_test_setup_teardown(test_find_floor_monster_blocked, setup_rooms_suite, teardown_rooms_suite),
         cmocka_unit_test_setup_teardown(test_find_floor_with_null_room, setup_rooms_suite, teardown_rooms_suite),
+        cmocka_unit_test_setup_teardown(test_wanderer_full_level, setup_rooms_suite, teardown_rooms_suite),
+        cmocka_unit_test_setup_teardown(test_room_list_mlist_order, setup_rooms_suite, teardown_rooms_suite),
+        cmocka_unit_test_setup_teardown(test_room_monster_list, setup_rooms_suite, teardown_rooms_suite),
+        cmocka_unit_test_setup_teardown(test_dig_maze_reaches_every_cell, setup_rooms_suite, teardown_rooms_suite),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -17,6 +17,8 @@ extern int rs_write_char(FILE *savef, char c);
 extern int rs_read_char(FILE *inf, char *c);
 extern int rs_write_string(FILE *savef, char *s);
 extern int rs_read_string(FILE *inf, char *s, int max);
+extern int rs_write_rng(FILE *savef, RNG *rp);
+extern int rs_read_rng(FILE *inf, RNG *rp);
 
 /* Test: rs_write_int and rs_read_int round trip */
 static void test_rs_int_roundtrip(void **state) {
@@ -72,11 +74,38 @@ static void test_rs_string_roundtrip(void **state) {
     fclose(fp);
 }
 
+/* Test: rs_write_rng/rs_read_rng round trip, all 64 bits of key and state */
+static void test_rs_rng_roundtrip(void **state) {
+    (void) state;
+
+    FILE *fp = tmpfile();
+    RNG out, in;
+
+    assert_non_null(fp);
+    memset(&out, 0, sizeof out);
+    out.r_kind = RNG_FAST;
+    out.r_seed = -77;
+    out.r_key = 0x0123456789abcdefULL;
+    out.r_state = 0xfedcba9876543210ULL;
+    assert_int_equal(0, rs_write_rng(fp, &out));
+    rewind(fp);
+
+    memset(&in, 0, sizeof in);
+    assert_int_equal(0, rs_read_rng(fp, &in));
+    assert_int_equal(RNG_FAST, in.r_kind);
+    assert_int_equal(-77, in.r_seed);
+    assert_true(in.r_key == out.r_key);
+    assert_true(in.r_state == out.r_state);
+
+    fclose(fp);
+}
+
 int run_state_tests(void) {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_rs_int_roundtrip),
         cmocka_unit_test(test_rs_char_roundtrip),
         cmocka_unit_test(test_rs_string_roundtrip),
+        cmocka_unit_test(test_rs_rng_roundtrip),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
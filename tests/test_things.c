@@ -21,6 +21,7 @@ extern void discovered(void);
 extern void print_disc(char type);
 extern void set_order(int *order, int numthings);
 extern char add_line(char *fmt, char *arg);
+extern char add_text(char *str);
 extern void end_line(void);
 extern char *nothing(char type);
 extern void nameit(THING *obj, int type, char *which, struct obj_info *op, char *(*prfunc)(THING *));
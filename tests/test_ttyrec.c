@@ -0,0 +1,50 @@
+/*
+ * Tests for ttyrec.c
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <string.h>
+#include <cmocka.h>
+#include <curses.h>
+#include "rogue.h"
+
+#define SPOT(c)	((uint32_t) (c) << 4)
+
+/* Test: a frame clears the screen once, then only what changed goes out */
+static void test_tty_diff_changes_only(void **state) {
+    (void) state;
+    uint32_t now[3 * 4], was[3 * 4];
+    char out[3 * 4 * 32 + 64];
+    int y = -1, x = -1, len;
+
+    for (int i = 0; i < 3 * 4; i++) {
+        now[i] = SPOT(' ');
+    }
+    now[1 * 4 + 1] = SPOT('@');
+    now[1 * 4 + 2] = SPOT('K') | 0x1;
+
+    len = tty_diff(now, was, 3, 4, &y, &x, 1, 1, out);
+    out[len] = '\0';
+    assert_string_equal("\033[H\033[2J\033[2;2H@\033[0;7mK\033[0m\033[2;2H", out);
+    assert_int_equal(1, y);
+    assert_int_equal(1, x);
+
+    len = tty_diff(now, was, 3, 4, &y, &x, 1, 1, out);
+    assert_int_equal(0, len);
+
+    now[1 * 4 + 1] = SPOT('.');
+    now[1 * 4 + 2] = SPOT('@');
+    len = tty_diff(now, was, 3, 4, &y, &x, 1, 2, out);
+    out[len] = '\0';
+    assert_string_equal(".@\033[2;3H", out);
+}
+
+int run_ttyrec_tests(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_tty_diff_changes_only),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
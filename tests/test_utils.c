@@ -107,6 +107,78 @@ static void test_spread_returns_distributed_value(void **state) {
     }
 }
 
+/* Test: 레거시 생성기가 원래 RN 매크로의 LCG와 같은 값을 내는지 확인 */
+static void test_rng_legacy_matches_old_lcg(void **state) {
+    (void) state;
+    RNG r;
+    unsigned int old = 12345;
+    rng_init(&r, RNG_LEGACY, 12345);
+    for (int i = 0; i < 100; i++) {
+        int val = rng_next(&r);
+        old = old * 11109 + 13849;
+        assert_int_equal((int) ((old >> 16) & 0xffff), val);
+    }
+}
+
+/* Test: 같은 시드의 두 생성기가 서로 영향을 주지 않고 같은 값을 내는지 확인 */
+static void test_rng_streams_are_independent(void **state) {
+    (void) state;
+    RNG a, b;
+    rng_init(&a, RNG_FAST, 42);
+    rng_init(&b, RNG_FAST, 42);
+    for (int i = 0; i < 10; i++)
+        rng_next(&a);
+    rng_init(&a, RNG_FAST, 42);
+    for (int i = 0; i < 100; i++) {
+        int va = rng_next(&a);
+        int vb = rng_next(&b);
+        assert_in_range(va, 0, 0x7fffffff);
+        assert_int_equal(va, vb);
+    }
+}
+
+/* Test: 레벨 스트림이 다른 스트림 사용과 무관하게 시드와 깊이로만 정해지는지 확인 */
+static void test_rng_level_stream_is_stable(void **state) {
+    (void) state;
+    int first[10], ors;
+    rng_seed(RNG_FAST, 7);
+    rng_level(3);
+    ors = rng_use(RS_LEVEL);
+    for (int i = 0; i < 10; i++)
+        first[i] = rnd(1000);
+    rng_use(ors);
+    rng_seed(RNG_FAST, 7);
+    ors = rng_use(RS_LOOK);
+    for (int i = 0; i < 50; i++)
+        rnd(1000);
+    rng_use(ors);
+    rnd(1000);
+    rng_level(3);
+    ors = rng_use(RS_LEVEL);
+    for (int i = 0; i < 10; i++) {
+        int val = rnd(1000);
+        assert_int_equal(first[i], val);
+    }
+    rng_use(ors);
+    assert_ptr_equal(&streams[RS_MAIN], rng);
+    rng_seed(RNG_LEGACY, 0);
+}
+
+/* Test: 빠른 생성기의 roll()과 roll_n()이 주사위 범위를 지키는지 확인 */
+static void test_roll_n_fast_in_range(void **state) {
+    (void) state;
+    int totals[500];
+    rng_seed(RNG_FAST, 99);
+    roll_n(totals, 500, 3, 6);
+    for (int i = 0; i < 500; i++)
+        assert_in_range(totals[i], 3, 18);
+    for (int i = 0; i < 100; i++) {
+        int val = roll(100, 8);
+        assert_in_range(val, 100, 800);
+    }
+    rng_seed(RNG_LEGACY, 0);
+}
+
 int run_utils_tests(void) {
     const struct CMUnitTest tests[] = {
         /* dist() and ce() tests */
@@ -121,6 +193,11 @@ int run_utils_tests(void) {
         cmocka_unit_test(test_roll_calculates_sum),
         cmocka_unit_test(test_sign_returns_correct_sign),
         cmocka_unit_test(test_spread_returns_distributed_value),
+        /* RNG tests */
+        cmocka_unit_test(test_rng_legacy_matches_old_lcg),
+        cmocka_unit_test(test_rng_streams_are_independent),
+        cmocka_unit_test(test_rng_level_stream_is_stable),
+        cmocka_unit_test(test_roll_n_fast_in_range),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -0,0 +1,51 @@
+/*
+ * Tests for watch.c
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <cmocka.h>
+#include <curses.h>
+#include "rogue.h"
+
+#define WATCH_FILE "/tmp/rogue_test_watch"
+
+/* Test: a file that no game published its screen in is not watched */
+static void test_watch_refuses_other_files(void **state) {
+    (void) state;
+    FILE *fp = fopen(WATCH_FILE, "w");
+
+    assert_non_null(fp);
+    fputs("not a screen\n", fp);
+    fclose(fp);
+    assert_false(watch(WATCH_FILE));
+    assert_false(watch("/nonexistent/rogue_watch"));
+    unlink(WATCH_FILE);
+}
+
+/* Test: watching a game that has already ended stops right away */
+static void test_watch_ended_game(void **state) {
+    (void) state;
+    uint32_t head[7] = { 0x52574631, 2, 3, 2, 0, 0, 1 };
+    uint32_t spots[2 * 3] = { 0 };
+    FILE *fp = fopen(WATCH_FILE, "wb");
+
+    assert_non_null(fp);
+    fwrite(head, sizeof head, 1, fp);
+    fwrite(spots, sizeof spots, 1, fp);
+    fclose(fp);
+    assert_true(watch(WATCH_FILE));
+    unlink(WATCH_FILE);
+}
+
+int run_watch_tests(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_watch_refuses_other_files),
+        cmocka_unit_test(test_watch_ended_game),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -18,13 +18,64 @@
 #include "i18n.h"
 #include "i18n_korean.h"
 
+static int name_gen = 1;		/* Bumped when all names must be made again */
+
 /*
- * inv_name:
- *	Return the name of something as it would appear in an
- *	inventory.
+ * forget_names:
+ *	Make every object's name again the next time it is asked for,
+ *	as when something it is made from but not kept in its NAMEKEY
+ *	has changed
  */
-char *
-inv_name(THING *obj, bool drop)
+void
+forget_names()
+{
+    name_gen++;
+}
+
+/*
+ * name_key:
+ *	Fill in what the name of an object is made from
+ */
+static void
+name_key(THING *obj, NAMEKEY *kp)
+{
+    struct obj_info *op;
+
+    memset(kp, 0, sizeof *kp);
+    kp->nk_gen = name_gen;
+    kp->nk_type = obj->o_type;
+    kp->nk_which = obj->o_which;
+    kp->nk_count = obj->o_count;
+    kp->nk_hplus = obj->o_hplus;
+    kp->nk_dplus = obj->o_dplus;
+    kp->nk_arm = obj->o_arm;
+    kp->nk_flags = obj->o_flags;
+    kp->nk_label = obj->o_label;
+    kp->nk_terse = terse;
+    switch (obj->o_type)
+    {
+	case POTION:
+	    op = pot_info;
+	when SCROLL:
+	    op = scr_info;
+	when RING:
+	    op = ring_info;
+	when STICK:
+	    op = ws_info;
+	otherwise:
+	    return;
+    }
+    kp->nk_guess = op[obj->o_which].oi_guess;
+    kp->nk_know = op[obj->o_which].oi_know;
+}
+
+/*
+ * make_name:
+ *	Put the name of something into prbuf, without saying how it
+ *	is being used
+ */
+static void
+make_name(THING *obj)
 {
     char *pb;
     struct obj_info *op;
@@ -203,16 +254,44 @@ inv_name(THING *obj, bool drop)
 	    sprintf(pb, msg_get("MSG_THING_BIZARRE"), unctrl(obj->o_type));
 #endif
     }
+}
+
+/*
+ * inv_name:
+ *	Return the name of something as it would appear in an
+ *	inventory.  The name is kept with the object, so it is only
+ *	made again when something it was made from has changed.
+ */
+char *
+inv_name(THING *obj, bool drop)
+{
+    NAMEKEY key;
+
+    name_key(obj, &key);
+    if (memcmp(&key, &obj->o_invkey, sizeof key) == 0)
+	strcpy(prbuf, obj->o_invname);
+    else
+    {
+	make_name(obj);
+	prbuf[MAXSTR-1] = '\0';
+	if (strlen(prbuf) < sizeof obj->o_invname)
+	{
+	    strcpy(obj->o_invname, prbuf);
+	    memcpy(&obj->o_invkey, &key, sizeof key);
+	}
+	else
+	    obj->o_invkey.nk_gen = 0;
+    }
     if (inv_describe)
     {
 	if (obj == cur_armor)
-	    strcat(pb, msg_get("MSG_THING_BEING_WORN"));
+	    strcat(prbuf, msg_get("MSG_THING_BEING_WORN"));
 	if (obj == cur_weapon)
-	    strcat(pb, msg_get("MSG_THING_WEAPON_IN_HAND"));
+	    strcat(prbuf, msg_get("MSG_THING_WEAPON_IN_HAND"));
 	if (obj == cur_ring[LEFT])
-	    strcat(pb, msg_get("MSG_THING_ON_LEFT_HAND"));
+	    strcat(prbuf, msg_get("MSG_THING_ON_LEFT_HAND"));
 	else if (obj == cur_ring[RIGHT])
-	    strcat(pb, msg_get("MSG_THING_ON_RIGHT_HAND"));
+	    strcat(prbuf, msg_get("MSG_THING_ON_RIGHT_HAND"));
     }
     if (drop && isupper(prbuf[0]))
 	prbuf[0] = (char) tolower(prbuf[0]);
@@ -248,10 +327,10 @@ drop()
     /*
      * Link it into the level object list
      */
-    attach(lvl_obj, obj);
+    obj->o_pos = hero;
+    attach_obj(obj);
     chat(hero.y, hero.x) = (char) obj->o_type;
     flat(hero.y, hero.x) |= F_DROPPED;
-    obj->o_pos = hero;
     if (obj->o_type == AMULET)
 	amulet = FALSE;
     msg(msg_get("MSG_THING_DROPPED"), inv_name(obj, TRUE));
@@ -425,7 +504,12 @@ static int line_cnt = 0;
 
 static bool newpage = FALSE;
 
-static char *lastfmt, *lastarg;
+static char *lastline;
+
+GAMEVAR things_vars[] = {
+    GV(line_cnt), GV(newpage), GV(lastline),
+    GV_END
+};
 
 
 void
@@ -524,7 +608,7 @@ print_disc(char type)
 	{
 	    obj.o_type = type;
 	    obj.o_which = order[i];
-	    add_line("%s", inv_name(&obj, FALSE));
+	    add_text(inv_name(&obj, FALSE));
 	    num_found++;
 	}
     if (num_found == 0)
@@ -560,6 +644,21 @@ set_order(int *order, int numthings)
 /* VARARGS1 */
 char
 add_line(char *fmt, char *arg)
+{
+    static char buf[MAXSTR];
+
+    if (fmt == NULL)
+	return add_text(NULL);
+    snprintf(buf, sizeof buf, fmt, arg);
+    return add_text(buf);
+}
+
+/*
+ * add_text:
+ *	Add a line that needs no formatting to the list
+ */
+char
+add_text(char *str)
 {
     WINDOW *tw, *sw;
     int x, y;
@@ -574,8 +673,8 @@ add_line(char *fmt, char *arg)
     }
     if (inv_type == INV_SLOW)
     {
-	if (*fmt != '\0')
-	    if (msg(fmt, arg) == ESCAPE)
+	if (*str != '\0')
+	    if (msg("%s", str) == ESCAPE)
 		return ESCAPE;
 	line_cnt++;
     }
@@ -583,9 +682,9 @@ add_line(char *fmt, char *arg)
     {
 	if (maxlen < 0)
 	    maxlen = (int) strlen(prompt);
-	if (line_cnt >= LINES - 1 || fmt == NULL)
+	if (line_cnt >= LINES - 1 || str == NULL)
 	{
-	    if (inv_type == INV_OVER && fmt == NULL && !newpage)
+	    if (inv_type == INV_OVER && str == NULL && !newpage)
 	    {
 		msg("");
 		refresh();
@@ -635,14 +734,13 @@ add_line(char *fmt, char *arg)
 	    line_cnt = 0;
 	    maxlen = (int) strlen(prompt);
 	}
-	if (fmt != NULL && !(line_cnt == 0 && *fmt == '\0'))
+	if (str != NULL && !(line_cnt == 0 && *str == '\0'))
 	{
-	    mvwprintw(hw, line_cnt++, 0, fmt, arg);
+	    mvwaddstr(hw, line_cnt++, 0, str);
 	    getyx(hw, y, x);
 	    if (maxlen < x)
 		maxlen = x;
-	    lastfmt = fmt;
-	    lastarg = arg;
+	    lastline = str;
 	}
     }
     return ~ESCAPE;
@@ -661,10 +759,10 @@ end_line()
 	if (line_cnt == 1 && !newpage)
 	{
 	    mpos = 0;
-	    msg(lastfmt, lastarg);
+	    msg("%s", lastline);
 	}
 	else
-	    add_line((char *) NULL, NULL);
+	    add_text(NULL);
     }
     line_cnt = 0;
     newpage = FALSE;
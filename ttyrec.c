@@ -0,0 +1,330 @@
+/*
+ * Recording what is on the screen as a ttyrec, for watching games
+ * later with ttyplay or anything else that reads the format
+ *
+ * Each frame is a header of three little-endian 32-bit words (seconds,
+ * microseconds, length) and then that many bytes of terminal output.
+ * The output is made here, as plain ANSI, from the spots on curscr
+ * that changed since the last frame, so it does not matter how curses
+ * talks to the terminal.  Frames pile up in a large buffer which only
+ * goes out while the game is waiting for a key.
+ *
+ * Rogue: Exploring the Dungeons of Doom
+ * Copyright (C) 1980-1983, 1985, 1999 Michael Toy, Ken Arnold and Glenn Wichman
+ * All rights reserved.
+ *
+ * See the file LICENSE.TXT for full copyright and licensing information.
+ */
+
+#define NCURSES_WIDECHAR 1		/* To read back wide characters */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <curses.h>
+#include "rogue.h"
+#include "extern.h"
+
+#define TR_STANDOUT	0x1		/* Attribute bits of a spot */
+#define TR_BOLD		0x2
+#define TR_UNDER	0x4
+#define TR_RIGHT	0x8		/* Right half of a wide character */
+#define TR_ATTRS	(TR_STANDOUT|TR_BOLD|TR_UNDER)
+#define TR_HEAD		12		/* Bytes in a frame header */
+#define TR_BUFSIZ	(64 * 1024)	/* Bytes of frames kept back */
+#define TR_SPOTLEN	32		/* Most output one spot can need */
+
+/*
+ * What goes into a spot: the character shifted up past the attributes
+ */
+#define TR_SPOT(c, a)	(((uint32_t) (c) << 4) | (a))
+#define TR_CHAR(s)	((s) >> 4)
+#define TR_WIDE(c)	((c) >= 0x1100)	/* Hangul and the like take two */
+
+static FILE *tty_fp = NULL;		/* Where frames are going */
+static char tty_name[MAXSTR];		/* And what it was called */
+static char tty_buf[TR_BUFSIZ];	/* Held back for tty_fp */
+static uint32_t *now_spots = NULL;	/* What curscr has */
+static uint32_t *was_spots = NULL;	/* What the last frame showed */
+static char *frame = NULL;		/* The frame being put together */
+static int tty_lines, tty_cols;		/* Size of the arrays */
+static int last_y, last_x;		/* Where the last frame left the cursor */
+
+/*
+ * put_utf8:
+ *	Put a character into buf as UTF-8, returning how many bytes it took
+ */
+
+static int
+put_utf8(char *buf, uint32_t c)
+{
+    if (c < 0x80)
+    {
+	buf[0] = (char) c;
+	return 1;
+    }
+    if (c < 0x800)
+    {
+	buf[0] = (char) (0xc0 | (c >> 6));
+	buf[1] = (char) (0x80 | (c & 0x3f));
+	return 2;
+    }
+    if (c < 0x10000)
+    {
+	buf[0] = (char) (0xe0 | (c >> 12));
+	buf[1] = (char) (0x80 | ((c >> 6) & 0x3f));
+	buf[2] = (char) (0x80 | (c & 0x3f));
+	return 3;
+    }
+    buf[0] = (char) (0xf0 | (c >> 18));
+    buf[1] = (char) (0x80 | ((c >> 12) & 0x3f));
+    buf[2] = (char) (0x80 | ((c >> 6) & 0x3f));
+    buf[3] = (char) (0x80 | (c & 0x3f));
+    return 4;
+}
+
+/*
+ * put_sgr:
+ *	Put into buf what sets the terminal to show attributes attr,
+ *	returning how many bytes it took
+ */
+
+static int
+put_sgr(char *buf, int attr)
+{
+    char *bp = buf;
+
+    *bp++ = '\033';
+    *bp++ = '[';
+    *bp++ = '0';
+    if (attr & TR_STANDOUT)
+    {
+	*bp++ = ';';
+	*bp++ = '7';
+    }
+    if (attr & TR_BOLD)
+    {
+	*bp++ = ';';
+	*bp++ = '1';
+    }
+    if (attr & TR_UNDER)
+    {
+	*bp++ = ';';
+	*bp++ = '4';
+    }
+    *bp++ = 'm';
+    return (int) (bp - buf);
+}
+
+/*
+ * tty_diff:
+ *	Put into out the terminal output that changes a screen showing
+ *	was into one showing now, and moves the cursor from (*yp, *xp)
+ *	to (cy, cx).  Returns how many bytes it took, TR_SPOTLEN a spot
+ *	at most.  was is brought up to date along with the cursor.  A
+ *	*yp of -1 means nothing is known about the screen, so it is
+ *	cleared first.
+ */
+
+int
+tty_diff(uint32_t *now, uint32_t *was, int lines, int cols, int *yp, int *xp,
+    int cy, int cx, char *out)
+{
+    char *op = out;
+    int y, x, n, attr = 0;
+    uint32_t s;
+
+    if (*yp < 0)
+    {
+	strcpy(op, "\033[H\033[2J");
+	op += 7;
+	for (n = 0; n < lines * cols; n++)
+	    was[n] = TR_SPOT(' ', 0);
+	*yp = *xp = 0;
+    }
+    for (y = 0; y < lines; y++)
+	for (x = 0; x < cols; x++)
+	{
+	    n = y * cols + x;
+	    if ((s = now[n]) == was[n])
+		continue;
+	    was[n] = s;
+	    if (s & TR_RIGHT)		/* went out with its left half */
+		continue;
+	    if (y != *yp || x != *xp)
+		op += sprintf(op, "\033[%d;%dH", y + 1, x + 1);
+	    if ((int) (s & TR_ATTRS) != attr)
+	    {
+		attr = (int) (s & TR_ATTRS);
+		op += put_sgr(op, attr);
+	    }
+#ifdef CCHARW_MAX
+	    op += put_utf8(op, TR_CHAR(s));
+#else
+	    *op++ = (char) TR_CHAR(s);
+#endif
+	    *yp = y;
+	    *xp = x + (TR_WIDE(TR_CHAR(s)) ? 2 : 1);
+	    if (*xp >= cols)		/* where it is now depends on the terminal */
+		*xp = -1;
+	}
+    if (attr != 0)
+	op += put_sgr(op, 0);
+    if (cy != *yp || cx != *xp)
+	op += sprintf(op, "\033[%d;%dH", cy + 1, cx + 1);
+    *yp = cy;
+    *xp = cx;
+    return (int) (op - out);
+}
+
+/*
+ * read_spots:
+ *	Take what is on the screen from curscr into the lines by cols
+ *	spots at sp, and say where the cursor is
+ */
+
+void
+read_spots(uint32_t *sp, int lines, int cols, int *cyp, int *cxp)
+{
+    int y, x, right;
+    uint32_t c, a;
+#ifdef CCHARW_MAX
+    cchar_t cc;
+    wchar_t wc[CCHARW_MAX + 1];
+    attr_t at;
+    short pair;
+#else
+    chtype at;
+#endif
+
+    getyx(curscr, *cyp, *cxp);
+    for (y = 0; y < lines; y++)
+    {
+	right = FALSE;
+	for (x = 0; x < cols; x++)
+	{
+#ifdef CCHARW_MAX
+	    mvwin_wch(curscr, y, x, &cc);
+	    getcchar(&cc, wc, &at, &pair, NULL);
+	    c = (uint32_t) wc[0];
+#else
+	    at = mvwinch(curscr, y, x);
+	    c = (uint32_t) (at & A_CHARTEXT);
+#endif
+	    if (c < ' ')
+		c = ' ';
+	    a = 0;
+	    if (at & (A_STANDOUT|A_REVERSE))
+		a |= TR_STANDOUT;
+	    if (at & A_BOLD)
+		a |= TR_BOLD;
+	    if (at & A_UNDERLINE)
+		a |= TR_UNDER;
+	    if (right)
+	    {
+		a |= TR_RIGHT;
+		right = FALSE;
+	    }
+	    else
+		right = TR_WIDE(c);
+	    *sp++ = TR_SPOT(c, a);
+	}
+    }
+    wmove(curscr, *cyp, *cxp);
+}
+
+/*
+ * open_ttyrec:
+ *	Start a new recording in tty_file, when the option has changed
+ */
+
+static void
+open_ttyrec()
+{
+    if (tty_fp != NULL)
+	fclose(tty_fp);
+    strcpy(tty_name, tty_file);
+    if (tty_name[0] == '\0' || (tty_fp = fopen(tty_name, "wb")) == NULL)
+    {
+	tty_fp = NULL;
+	return;
+    }
+    setvbuf(tty_fp, tty_buf, _IOFBF, sizeof tty_buf);
+    if (now_spots == NULL || tty_lines != LINES || tty_cols != COLS)
+    {
+	free(now_spots);
+	free(was_spots);
+	free(frame);
+	tty_lines = LINES;
+	tty_cols = COLS;
+	now_spots = malloc(tty_lines * tty_cols * sizeof *now_spots);
+	was_spots = malloc(tty_lines * tty_cols * sizeof *was_spots);
+	frame = malloc(TR_HEAD + tty_lines * tty_cols * TR_SPOTLEN + TR_SPOTLEN);
+	if (now_spots == NULL || was_spots == NULL || frame == NULL)
+	{
+	    fclose(tty_fp);
+	    tty_fp = NULL;
+	    return;
+	}
+    }
+    last_y = -1;
+}
+
+/*
+ * put_word:
+ *	Put a 32-bit word into buf, low byte first
+ */
+
+static void
+put_word(char *buf, uint32_t w)
+{
+    buf[0] = (char) (w & 0xff);
+    buf[1] = (char) ((w >> 8) & 0xff);
+    buf[2] = (char) ((w >> 16) & 0xff);
+    buf[3] = (char) ((w >> 24) & 0xff);
+}
+
+/*
+ * put_ttyrec:
+ *	Add what changed on the screen to tty_file as one frame.  While
+ *	the game waits for a key, the frames held back go out too.
+ */
+
+void
+put_ttyrec(bool waiting)
+{
+    int len, cy, cx;
+    long ms;
+
+    if (strcmp(tty_name, tty_file) != 0)
+	open_ttyrec();
+    if (tty_fp == NULL)
+	return;
+    read_spots(now_spots, tty_lines, tty_cols, &cy, &cx);
+    len = tty_diff(now_spots, was_spots, tty_lines, tty_cols, &last_y, &last_x,
+	cy, cx, frame + TR_HEAD);
+    if (len > 0)
+    {
+	ms = md_msecs();
+	put_word(frame, (uint32_t) (ms / 1000));
+	put_word(frame + 4, (uint32_t) (ms % 1000 * 1000));
+	put_word(frame + 8, (uint32_t) len);
+	fwrite(frame, TR_HEAD + len, 1, tty_fp);
+    }
+    if (waiting)
+	fflush(tty_fp);
+}
+
+/*
+ * end_ttyrec:
+ *	Finish the recording.  The screen may be gone by now, so the
+ *	last frame is the one taken when a key was last waited for.
+ */
+
+void
+end_ttyrec()
+{
+    if (tty_fp == NULL)
+	return;
+    fclose(tty_fp);
+    tty_fp = NULL;
+}
@@ -2,17 +2,178 @@
 #include "rogue.h" // For coord type and RN macro
 #include <stdlib.h> // For abs
 
+#define DICE_BLOCK	64	/* Dice drawn at a time by roll() and roll_n() */
+
+/*
+ * The splitmix64 finalizer: scramble a 64-bit number thoroughly.
+ */
+static uint64_t mix64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+/*
+ * Seed a generator.
+ */
+void rng_init(RNG *rp, int kind, int seed) {
+    rp->r_kind = kind;
+    rp->r_seed = seed;
+    rp->r_key = mix64((uint64_t) (unsigned int) seed);
+    rp->r_state = 0;
+}
+
+/*
+ * Make rp stream number n of the given subsystem, derived from the seed
+ * of the game that from belongs to.  The fast generator is counter
+ * based, so the stream is just a new key with the count started over.
+ */
+void rng_fork(RNG *rp, RNG *from, int stream, int n) {
+    rp->r_kind = from->r_kind;
+    rp->r_seed = from->r_seed;
+    rp->r_key = mix64(from->r_key + (uint64_t) stream * 0x9e3779b97f4a7c15ULL
+        + (uint64_t) (unsigned int) n * 0xd1b54a32d192ed03ULL);
+    rp->r_state = 0;
+}
+
+/*
+ * Next number from a generator: 16 bits from the legacy one, 31 from
+ * the fast one (splitmix64 of key and count).
+ */
+int rng_next(RNG *rp) {
+    unsigned int s;
+
+    if (rp->r_kind == RNG_LEGACY) {
+        s = (unsigned int) rp->r_seed * 11109 + 13849;
+        rp->r_seed = (int) s;
+        return (s >> 16) & 0xffff;
+    }
+    return (int) (mix64(rp->r_key + ++rp->r_state * 0x9e3779b97f4a7c15ULL)
+        >> 33);
+}
+
+/*
+ * Seed all the streams of the current game.  The legacy generator has
+ * just the one stream that everything draws from, as it always did.
+ */
+void rng_seed(int kind, int seed) {
+    int i;
+
+    rng_init(&streams[RS_MAIN], kind, seed);
+    for (i = RS_MAIN + 1; i < NSTREAMS; i++)
+        rng_fork(&streams[i], &streams[RS_MAIN], i, 0);
+    rng = &streams[RS_MAIN];
+}
+
+/*
+ * Start the level stream over for digging the given level, so that a
+ * level depends only on the game seed and its depth.
+ */
+void rng_level(int depth) {
+    if (streams[RS_MAIN].r_kind != RNG_LEGACY)
+        rng_fork(&streams[RS_LEVEL], &streams[RS_MAIN], RS_LEVEL, depth);
+}
+
+/*
+ * Draw from the given subsystem's stream until told otherwise.  Returns
+ * the stream that was in use, so it can be put back.
+ */
+int rng_use(int which) {
+    int old;
+
+    old = (int) (rng - streams);
+    if (streams[RS_MAIN].r_kind != RNG_LEGACY)
+        rng = &streams[which];
+    return old;
+}
+
+/*
+ * Fill buf with n raw numbers from a generator: 32 bits each from the
+ * fast one, 16 from the legacy one.  Each fast number depends only on
+ * the key and its count, so the loop has nothing carried from one
+ * number to the next and the compiler can vectorize it.
+ */
+void rng_block(RNG *rp, uint32_t *buf, int n) {
+    uint64_t base;
+    int i;
+
+    if (rp->r_kind == RNG_LEGACY) {
+        for (i = 0; i < n; i++)
+            buf[i] = (uint32_t) rng_next(rp);
+        return;
+    }
+    base = rp->r_state;
+    for (i = 0; i < n; i++)
+        buf[i] = (uint32_t) (mix64(rp->r_key
+            + (base + i + 1) * 0x9e3779b97f4a7c15ULL) >> 32);
+    rp->r_state = base + n;
+}
+
+/*
+ * Pick a number in [0, range).  The fast generator scales with a
+ * multiply and shift instead of taking a remainder.
+ */
 int rnd(int range) {
+    if (range > 0 && rng->r_kind != RNG_LEGACY)
+        return (int) (((uint64_t) rng_next(rng) * (uint64_t) range) >> 31);
     return range == 0 ? 0 : abs((int) RN) % range;
 }
 
+/*
+ * Roll number dice of the given sides.  The legacy generator rolls
+ * them one at a time as it always has; the fast one draws them in
+ * blocks.
+ */
 int roll(int number, int sides) {
+    uint32_t buf[DICE_BLOCK];
     int dtotal = 0;
-    while (number--)
-        dtotal += rnd(sides) + 1;
+    int i, n;
+
+    if (rng->r_kind == RNG_LEGACY || sides <= 0) {
+        while (number--)
+            dtotal += rnd(sides) + 1;
+        return dtotal;
+    }
+    while (number > 0) {
+        n = (number < DICE_BLOCK ? number : DICE_BLOCK);
+        rng_block(rng, buf, n);
+        for (i = 0; i < n; i++)
+            dtotal += (int) (((uint64_t) buf[i] * (uint32_t) sides) >> 32);
+        dtotal += n;
+        number -= n;
+    }
     return dtotal;
 }
 
+/*
+ * Roll the same dice n times over, putting each total in out.  With the
+ * fast generator the dice for all the totals come out of one run of
+ * blocks, so it pays off for many small rolls; the numbers left over
+ * in the last block are thrown away.
+ */
+void roll_n(int *out, int n, int number, int sides) {
+    uint32_t buf[DICE_BLOCK];
+    int i, d, total, used;
+
+    if (rng->r_kind == RNG_LEGACY || sides <= 0) {
+        for (i = 0; i < n; i++)
+            out[i] = roll(number, sides);
+        return;
+    }
+    used = DICE_BLOCK;
+    for (i = 0; i < n; i++) {
+        total = number;
+        for (d = 0; d < number; d++) {
+            if (used == DICE_BLOCK) {
+                rng_block(rng, buf, DICE_BLOCK);
+                used = 0;
+            }
+            total += (int) (((uint64_t) buf[used++] * (uint32_t) sides) >> 32);
+        }
+        out[i] = total;
+    }
+}
+
 int sign(int nm) {
     if (nm < 0)
         return -1;
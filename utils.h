@@ -4,8 +4,16 @@
 #include "rogue.h" // For coord type
 
 /* Function declarations for common utilities */
+void rng_init(RNG *rp, int kind, int seed);
+void rng_fork(RNG *rp, RNG *from, int stream, int n);
+int rng_next(RNG *rp);
+void rng_block(RNG *rp, uint32_t *buf, int n);
+void rng_seed(int kind, int seed);
+void rng_level(int depth);
+int rng_use(int which);
 int rnd(int range);
 int roll(int number, int sides);
+void roll_n(int *out, int n, int number, int sides);
 int sign(int nm);
 int spread(int nm);
 int dist(int y1, int x1, int y2, int x2);
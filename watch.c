@@ -0,0 +1,245 @@
+/*
+ * Letting others watch a game as it is played
+ *
+ * The game keeps what is on its screen in a file mapped into memory,
+ * the watch file: a header and then a spot for each place on the
+ * screen, as ttyrec.c makes them.  Whenever the screen changes the
+ * spots are rewritten, with the sequence number made odd while that
+ * goes on and even again after.  "rogue -w file" maps the same file,
+ * takes a copy whenever the sequence number has moved on and stayed
+ * even while it copied, and puts out what changed since its last
+ * copy.  The game never knows or cares how many are watching.
+ *
+ * Rogue: Exploring the Dungeons of Doom
+ * Copyright (C) 1980-1983, 1985, 1999 Michael Toy, Ken Arnold and Glenn Wichman
+ * All rights reserved.
+ *
+ * See the file LICENSE.TXT for full copyright and licensing information.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <curses.h>
+#include "rogue.h"
+#include "extern.h"
+#include "i18n.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+#define WT_MAGIC	0x52574631	/* "RWF1" */
+#define WT_POLL		20		/* Milliseconds between looks */
+#define WT_SPOTLEN	32		/* Most output one spot can need */
+
+#ifdef __GNUC__
+#define WT_BARRIER()	__sync_synchronize()
+#else
+#define WT_BARRIER()
+#endif
+
+typedef struct {
+    uint32_t wh_magic;			/* WT_MAGIC */
+    uint32_t wh_lines, wh_cols;		/* Size of the screen */
+    volatile uint32_t wh_seq;		/* Odd while the spots change */
+    volatile int32_t wh_y, wh_x;	/* Where the cursor is */
+    volatile uint32_t wh_over;		/* The game has ended */
+} WATCHHEAD;
+
+static WATCHHEAD *wt_head = NULL;	/* The mapped watch file */
+static uint32_t *wt_spots;		/* Its spots */
+static uint32_t *wt_now = NULL;		/* What curscr has now */
+static size_t wt_size;			/* Bytes mapped */
+static char wt_name[MAXSTR];		/* What it was called */
+
+/*
+ * close_watch:
+ *	Stop publishing the screen, telling the watchers it is over
+ */
+
+static void
+close_watch()
+{
+    if (wt_head == NULL)
+	return;
+    wt_head->wh_over = 1;
+    munmap((void *) wt_head, wt_size);
+    wt_head = NULL;
+}
+
+/*
+ * open_watch:
+ *	Set up watch_file, when the option has changed
+ */
+
+static void
+open_watch()
+{
+    int fd, lines, cols;
+
+    close_watch();
+    strcpy(wt_name, watch_file);
+    if (wt_name[0] == '\0')
+	return;
+    lines = LINES;
+    cols = COLS;
+    wt_size = sizeof *wt_head + lines * cols * sizeof *wt_spots;
+    if ((fd = open(wt_name, O_RDWR|O_CREAT|O_TRUNC, 0644)) < 0)
+	return;
+    if (ftruncate(fd, (off_t) wt_size) < 0
+	|| (wt_head = mmap(NULL, wt_size, PROT_READ|PROT_WRITE, MAP_SHARED,
+	    fd, 0)) == MAP_FAILED)
+	wt_head = NULL;
+    close(fd);
+    if (wt_head == NULL)
+	return;
+    free(wt_now);
+    if ((wt_now = malloc(lines * cols * sizeof *wt_now)) == NULL)
+    {
+	close_watch();
+	return;
+    }
+    wt_spots = (uint32_t *) (wt_head + 1);
+    wt_head->wh_lines = lines;
+    wt_head->wh_cols = cols;
+    wt_head->wh_seq = 0;
+    WT_BARRIER();
+    wt_head->wh_magic = WT_MAGIC;
+}
+
+/*
+ * put_watch:
+ *	Publish the screen, if it changed since it last was
+ */
+
+void
+put_watch()
+{
+    int cy, cx;
+    size_t len;
+
+    if (strcmp(wt_name, watch_file) != 0)
+	open_watch();
+    if (wt_head == NULL)
+	return;
+    read_spots(wt_now, wt_head->wh_lines, wt_head->wh_cols, &cy, &cx);
+    len = wt_head->wh_lines * wt_head->wh_cols * sizeof *wt_now;
+    if (memcmp(wt_now, wt_spots, len) == 0
+	&& cy == wt_head->wh_y && cx == wt_head->wh_x)
+	return;
+    wt_head->wh_seq++;
+    WT_BARRIER();
+    memcpy(wt_spots, wt_now, len);
+    wt_head->wh_y = cy;
+    wt_head->wh_x = cx;
+    WT_BARRIER();
+    wt_head->wh_seq++;
+}
+
+/*
+ * end_watch:
+ *	The game is over, as far as the watchers go
+ */
+
+void
+end_watch()
+{
+    close_watch();
+}
+
+/*
+ * watch:
+ *	Show the game publishing its screen in name until it ends
+ */
+
+bool
+watch(char *name)
+{
+    WATCHHEAD *hp;
+    struct stat sb;
+    uint32_t *now, *was, seq, last = 0;
+    char *out;
+    int fd, lines, cols, y = -1, x = -1, cy, cx, len;
+
+    if ((fd = open(name, O_RDONLY)) < 0 || fstat(fd, &sb) < 0)
+    {
+	perror(name);
+	return FALSE;
+    }
+    hp = NULL;
+    if ((size_t) sb.st_size >= sizeof *hp)
+	hp = mmap(NULL, (size_t) sb.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (hp == NULL || hp == MAP_FAILED || hp->wh_magic != WT_MAGIC
+	|| (size_t) sb.st_size < sizeof *hp
+	    + hp->wh_lines * hp->wh_cols * sizeof *now)
+    {
+	printf(msg_get("MSG_WATCH_NOT_WATCHABLE"), name);
+	printf("\n");
+	return FALSE;
+    }
+    lines = hp->wh_lines;
+    cols = hp->wh_cols;
+    now = malloc(lines * cols * sizeof *now);
+    was = malloc(lines * cols * sizeof *was);
+    out = malloc(lines * cols * WT_SPOTLEN + WT_SPOTLEN);
+    if (now == NULL || was == NULL || out == NULL)
+	return FALSE;
+    while (!hp->wh_over)
+    {
+	/*
+	 * Take a copy only once the game has finished changing it
+	 */
+	seq = hp->wh_seq;
+	if (seq == last || (seq & 1))
+	{
+	    md_msleep(WT_POLL);
+	    continue;
+	}
+	WT_BARRIER();
+	memcpy(now, (uint32_t *) (hp + 1), lines * cols * sizeof *now);
+	cy = hp->wh_y;
+	cx = hp->wh_x;
+	WT_BARRIER();
+	if (hp->wh_seq != seq)
+	    continue;
+	last = seq;
+	len = tty_diff(now, was, lines, cols, &y, &x, cy, cx, out);
+	fwrite(out, len, 1, stdout);
+	fflush(stdout);
+    }
+    printf("\033[%d;1H\n", lines);
+    printf(msg_get("MSG_WATCH_OVER"));
+    printf("\n");
+    return TRUE;
+}
+
+#else
+
+/*
+ * There is nothing to map a watch file with here
+ */
+
+void
+put_watch()
+{
+}
+
+void
+end_watch()
+{
+}
+
+bool
+watch(char *name)
+{
+    printf(msg_get("MSG_WATCH_NOT_WATCHABLE"), name);
+    printf("\n");
+    return FALSE;
+}
+
+#endif
@@ -85,12 +85,13 @@ do_motion(THING *obj, int ydelta, int xdelta)
 	/*
 	 * Erase the old one
 	 */
-	if (!ce(obj->o_pos, hero) && cansee(unc(obj->o_pos)) && !terse)
+	if (!ce(obj->o_pos, hero) && cansee(unc(obj->o_pos)) && !terse
+	    && animate)
 	{
 	    ch = chat(obj->o_pos.y, obj->o_pos.x);
 	    if (ch == FLOOR && !show_floor())
 		ch = ' ';
-	    mvaddch(obj->o_pos.y, obj->o_pos.x, ch);
+	    mvshow(obj->o_pos.y, obj->o_pos.x, ch);
 	}
 	/*
 	 * Get the new position
@@ -103,10 +104,10 @@ do_motion(THING *obj, int ydelta, int xdelta)
 	     * It hasn't hit anything yet, so display it
 	     * If it alright.
 	     */
-	    if (cansee(unc(obj->o_pos)) && !terse)
+	    if (cansee(unc(obj->o_pos)) && !terse && animate)
 	    {
-		mvaddch(obj->o_pos.y, obj->o_pos.x, obj->o_type);
-		refresh();
+		mvshow(obj->o_pos.y, obj->o_pos.x, obj->o_type);
+		show_frame();
 	    }
 	    continue;
 	}
@@ -135,9 +136,9 @@ fall(THING *obj, bool pr)
 	    if (pp->p_monst != NULL)
 		pp->p_monst->t_oldch = (char) obj->o_type;
 	    else
-		mvaddch(fpos.y, fpos.x, obj->o_type);
+		mvshow(fpos.y, fpos.x, obj->o_type);
 	}
-	attach(lvl_obj, obj);
+	attach_obj(obj);
 	return;
     }
     if (pr)
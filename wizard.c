@@ -206,8 +206,9 @@ teleport()
 {
     static coord c;
 
-    mvaddch(hero.y, hero.x, floor_at());
-    find_floor((struct room *) NULL, &c, FALSE, TRUE);
+    mvshow(hero.y, hero.x, floor_at());
+    if (!find_floor((struct room *) NULL, &c, FALSE, TRUE))
+	c = hero;			/* Nowhere else to go */
     if (roomin(&c) != proom)
     {
 	leave_room(&hero);
@@ -219,7 +220,7 @@ teleport()
 	hero = c;
 	look(TRUE);
     }
-    mvaddch(hero.y, hero.x, PLAYER);
+    mvshow(hero.y, hero.x, PLAYER);
     /*
      * turn off ISHELD in case teleportation was done while fighting
      * a Flytrap